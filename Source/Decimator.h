@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Down-only half-band cascade that brings the HQ engine's mono mix back to the host rate
+// (juce::dsp::Oversampling has no down-only mode, so it would also run its up-sampling filters
+// every block). Each stage halves the rate with a polyphase IIR half-band: two chains of
+// first-order allpasses at the lower rate, one multiply-add per coefficient per output sample.
+// Coefficients from the elliptic half-band design (as in de Soras' HIIR):
+//  - last stage (to the host rate): 9 coefficients, passband to 0.23 x its input rate
+//    (20.3 kHz at 44.1 kHz), stopband from 0.27 at -112 dB
+//  - earlier stages: 3 coefficients, flat across the final band, -127 dB on everything that
+//    would fold into it (the last stage removes the rest)
+// The phase response is not linear; getLatencyInSamples() is the group delay at DC.
+class Neon37Decimator
+{
+public:
+    // order: 1-3 (2x, 4x, 8x). Allocates, so call from prepareToPlay only.
+    void prepare (int newOrder, int maxOutputSamples)
+    {
+        order = std::clamp (newOrder, 1, maxStages);
+        for (int s = 0; s < order; ++s)
+            stages[(std::size_t)s].setCoefficients (s == order - 1 ? lastStageCoefficients : earlyStageCoefficients);
+
+        work.assign ((std::size_t)maxOutputSamples << (order - 1), 0.0f);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& stage : stages)
+            stage.reset();
+    }
+
+    // Decimate numOutputSamples << order engine-rate samples from in into numOutputSamples at the host rate
+    void process (const float* in, float* out, int numOutputSamples) noexcept
+    {
+        for (int s = 0; s < order; ++s)
+        {
+            const int stageOutputSamples = numOutputSamples << (order - 1 - s);
+            stages[(std::size_t)s].process (s == 0 ? in : work.data(),
+                                            s == order - 1 ? out : work.data(),
+                                            stageOutputSamples);
+        }
+    }
+
+    // Group delay at DC, in host-rate samples
+    double getLatencyInSamples() const noexcept
+    {
+        double latency = 0.0;
+        for (int s = 0; s < order; ++s)
+            latency += stages[(std::size_t)s].getDelayInInputSamples() / (double)(1 << (order - s));
+        return latency;
+    }
+
+private:
+    static constexpr int maxStages = 3;
+    static constexpr int maxCoefficients = 9;
+
+    using Coefficients = std::array<float, maxCoefficients>;
+
+    static constexpr Coefficients lastStageCoefficients {
+        0.0327013902f, 0.1229219273f, 0.2509245293f, 0.3938482465f, 0.5334382038f,
+        0.6594405568f, 0.7691751798f, 0.8654980726f, 0.9549727484f
+    };
+    static constexpr Coefficients earlyStageCoefficients { 0.0569428469f, 0.2466415207f, 0.6500919070f };
+
+    // One 2:1 stage. Coefficients alternate between the two branches; branch 0 takes the later
+    // input sample of each pair, branch 1 the earlier one, and the output is their average.
+    struct Stage
+    {
+        Coefficients coefficients{};
+        int numCoefficients = 0;
+        std::array<float, maxCoefficients> x{}, y{};  // Allpass input and output history
+
+        void setCoefficients (const Coefficients& newCoefficients) noexcept
+        {
+            coefficients = newCoefficients;
+            numCoefficients = (int)std::count_if (coefficients.begin(), coefficients.end(),
+                                                  [] (float c) { return c != 0.0f; });
+        }
+
+        void reset() noexcept
+        {
+            x.fill (0.0f);
+            y.fill (0.0f);
+        }
+
+        // out may alias in: output sample i is written after input samples 2i and 2i + 1 are read
+        void process (const float* in, float* out, int numOutputSamples) noexcept
+        {
+            for (int i = 0; i < numOutputSamples; ++i)
+            {
+                float branch[2] = { in[2 * i + 1], in[2 * i] };
+
+                for (int c = 0; c < numCoefficients; ++c)
+                {
+                    float& sample = branch[c & 1];
+                    const float result = (sample - y[(std::size_t)c]) * coefficients[(std::size_t)c] + x[(std::size_t)c];
+                    x[(std::size_t)c] = sample;
+                    y[(std::size_t)c] = result;
+                    sample = result;
+                }
+
+                out[i] = 0.5f * (branch[0] + branch[1]);
+            }
+        }
+
+        // Each allpass (c + z^-1) / (1 + c z^-1) delays DC by (1 - c) / (1 + c) samples at the
+        // lower rate, twice that at the input rate. Averaging the branches gives the sum over all
+        // coefficients, less half a sample because branch 0 reads the later input of each pair
+        // (output i is timed at input 2i).
+        double getDelayInInputSamples() const noexcept
+        {
+            double delay = -0.5;
+            for (int c = 0; c < numCoefficients; ++c)
+                delay += (1.0 - coefficients[(std::size_t)c]) / (1.0 + coefficients[(std::size_t)c]);
+            return delay;
+        }
+    };
+
+    std::array<Stage, maxStages> stages;
+    std::vector<float> work;   // Intermediate rates (each stage decimates in place)
+    int order = 1;
+};
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// ADSR envelopes for numLanes voices at once. Every stage is one affine step per sample,
+// value = base + value * coefficient, with base and coefficient fixed per stage:
+//  - linear (env_exp_curv off): coefficient 1 and base the per-sample ramp, like juce::ADSR
+//  - exponential: a one-pole approach to a target just past the stage's end level, so the attack
+//    is a rising RC curve and decay/release fall exponentially, each reaching its end level in
+//    the set time
+// The state lives in arrays and the per-sample update is branch-free, so the lanes vectorize.
+// process (out, numSamples) renders a whole run of samples; while every lane is idle or
+// sustaining (isSteady) nothing moves, so the run is filled without stepping.
+template <int laneCount>
+struct Neon37EnvelopeGenerator
+{
+    static constexpr int numLanes = laneCount;
+
+    enum Stage : int { idle = 0, attack, decay, sustain, release };
+
+    alignas (32) std::array<float, numLanes> value{};
+    alignas (32) std::array<float, numLanes> releaseBase{};  // Per lane: a linear release ramps from the note-off level
+    alignas (32) std::array<float, numLanes> stage{};        // Stage codes stored as float so the update stays in one vector type
+
+    void setSampleRate (double newSampleRate)
+    {
+        sampleRate = (float)newSampleRate;
+        setParameters (parameters, exponential);
+    }
+
+    void setParameters (const juce::ADSR::Parameters& newParameters, bool useExponentialCurves)
+    {
+        parameters = newParameters;
+        exponential = useExponentialCurves;
+        sustainLevel = parameters.sustain;
+        hasDecay = parameters.decay > 0.0f && sustainLevel < 1.0f;
+
+        // Zero-length stages complete in one step (the step overshoots and is clamped)
+        const float attackSamples = parameters.attack * sampleRate;
+        const float decaySamples = parameters.decay * sampleRate;
+        const float releaseSamples = parameters.release * sampleRate;
+
+        if (exponential)
+        {
+            attackCoefficient = approachCoefficient (attackSamples, 1.0f + attackOvershoot, attackOvershoot);
+            attackBase = attackSamples > 0.0f ? (1.0f + attackOvershoot) * (1.0f - attackCoefficient) : 2.0f;
+            decayCoefficient = approachCoefficient (decaySamples, 1.0f - sustainLevel + fallOvershoot, fallOvershoot);
+            decayBase = decaySamples > 0.0f ? (sustainLevel - fallOvershoot) * (1.0f - decayCoefficient) : -2.0f;
+            releaseCoefficient = approachCoefficient (releaseSamples, 1.0f + fallOvershoot, fallOvershoot);
+        }
+        else
+        {
+            attackCoefficient = decayCoefficient = releaseCoefficient = 1.0f;
+            attackBase = attackSamples > 0.0f ? 1.0f / attackSamples : 2.0f;
+            decayBase = decaySamples > 0.0f ? -(1.0f - sustainLevel) / decaySamples : -2.0f;
+        }
+    }
+
+    void noteOn (int lane)
+    {
+        if (parameters.attack > 0.0f)
+        {
+            stage[(size_t)lane] = (float)attack;  // From the current level, like juce::ADSR
+        }
+        else if (hasDecay)
+        {
+            value[(size_t)lane] = 1.0f;
+            stage[(size_t)lane] = (float)decay;
+        }
+        else
+        {
+            value[(size_t)lane] = sustainLevel;
+            stage[(size_t)lane] = (float)sustain;
+        }
+    }
+
+    void noteOff (int lane)
+    {
+        if (stage[(size_t)lane] == (float)idle)
+            return;
+
+        if (parameters.release > 0.0f)
+        {
+            // Linear: the same time from any level. Exponential: the same curve from any level.
+            releaseBase[(size_t)lane] = exponential ? -fallOvershoot * (1.0f - releaseCoefficient)
+                                                    : -value[(size_t)lane] / (parameters.release * sampleRate);
+            stage[(size_t)lane] = (float)release;
+        }
+        else
+        {
+            reset (lane);
+        }
+    }
+
+    void reset (int lane)
+    {
+        value[(size_t)lane] = 0.0f;
+        stage[(size_t)lane] = (float)idle;
+    }
+
+    Stage getStage (int lane) const { return (Stage)(int)stage[(size_t)lane]; }
+    bool isActive (int lane) const  { return stage[(size_t)lane] != (float)idle; }
+
+    // Below floor and not rising (decay, sustain or release), so inaudible from here on
+    bool isBelow (int lane, float floor) const
+    {
+        const float s = stage[(size_t)lane];
+        return s != (float)idle && s != (float)attack && value[(size_t)lane] < floor;
+    }
+
+    // Every lane idle or sustaining: the values cannot change until the next note-on/off
+    bool isSteady() const noexcept
+    {
+        bool steady = true;
+        for (int i = 0; i < numLanes; ++i)
+            steady = steady && (stage[(size_t)i] == (float)idle || stage[(size_t)i] == (float)sustain);
+        return steady;
+    }
+
+    // Advance every lane by one sample and write the new values to out[lane]
+    void process (float* out) noexcept
+    {
+        const float afterAttack = hasDecay ? (float)decay : (float)sustain;
+
+        for (int i = 0; i < numLanes; ++i)
+        {
+            const float s = stage[(size_t)i];
+            const float v = value[(size_t)i];
+
+            const float attackValue = attackBase + v * attackCoefficient;
+            const float decayValue = decayBase + v * decayCoefficient;
+            const float releaseValue = releaseBase[(size_t)i] + v * releaseCoefficient;
+
+            const bool attackDone = attackValue >= 1.0f;
+            const bool decayDone = decayValue <= sustainLevel;
+            const bool releaseDone = releaseValue <= 0.0f;
+
+            // Sequential selects (rather than nested ?:) keep the loop body if-convertible
+            float newValue = 0.0f;
+            newValue = s == (float)attack  ? (attackDone ? 1.0f : attackValue) : newValue;
+            newValue = s == (float)decay   ? (decayDone ? sustainLevel : decayValue) : newValue;
+            newValue = s == (float)sustain ? sustainLevel : newValue;
+            newValue = s == (float)release ? (releaseDone ? 0.0f : releaseValue) : newValue;
+
+            float newStage = s;
+            newStage = (s == (float)attack && attackDone) ? afterAttack : newStage;
+            newStage = (s == (float)decay && decayDone) ? (float)sustain : newStage;
+            newStage = (s == (float)release && releaseDone) ? (float)idle : newStage;
+
+            value[(size_t)i] = newValue;
+            stage[(size_t)i] = newStage;
+            out[i] = newValue;
+        }
+    }
+
+    // Render numSamples samples of every lane into out, interleaved by lane: sample s of lane v
+    // is at [s * numLanes + v] (a plain buffer when numLanes is 1)
+    void process (float* out, int numSamples) noexcept
+    {
+        if (! isSteady())
+        {
+            for (int sample = 0; sample < numSamples; ++sample)
+                process (out + sample * numLanes);
+            return;
+        }
+
+        // Idle lanes sit at 0, sustaining lanes at the (possibly just changed) sustain level
+        for (int i = 0; i < numLanes; ++i)
+            value[(size_t)i] = stage[(size_t)i] == (float)sustain ? sustainLevel : 0.0f;
+
+        if (numLanes == 1)
+        {
+            std::fill (out, out + numSamples, value[0]);
+            return;
+        }
+
+        for (int sample = 0; sample < numSamples; ++sample)
+            std::copy (value.begin(), value.end(), out + sample * numLanes);
+    }
+
+private:
+    // Exponential targets lie this far past the end level (as a fraction of full scale): a gentle
+    // curve for the attack, a close approach (about -80 dB) for decay and release
+    static constexpr float attackOvershoot = 0.3f;
+    static constexpr float fallOvershoot = 0.0001f;
+
+    // One-pole coefficient that covers span minus overshoot of the distance to its target in numSamples
+    static float approachCoefficient (float numSamples, float span, float overshoot)
+    {
+        return numSamples > 0.0f ? std::exp (-std::log (span / overshoot) / numSamples) : 0.0f;
+    }
+
+    juce::ADSR::Parameters parameters;
+    bool exponential = false;
+    float sampleRate = 44100.0f;
+    float sustainLevel = 1.0f;
+    bool hasDecay = false;
+
+    // value = base + value * coefficient per stage (the release base is per lane)
+    float attackBase = 2.0f, attackCoefficient = 1.0f;
+    float decayBase = -2.0f, decayCoefficient = 1.0f;
+    float releaseCoefficient = 1.0f;
+};
+
+// One envelope (the shared Mono/Para envelopes)
+struct Neon37Envelope : Neon37EnvelopeGenerator<1>
+{
+    using Lanes = Neon37EnvelopeGenerator<1>;
+    using Lanes::process;
+
+    void noteOn()                      { Lanes::noteOn (0); }
+    void noteOff()                     { Lanes::noteOff (0); }
+    void reset()                       { Lanes::reset (0); }
+    Stage getStage() const             { return Lanes::getStage (0); }
+    bool isActive() const              { return Lanes::isActive (0); }
+    bool isBelow (float floor) const   { return Lanes::isBelow (0, floor); }
+    float getValue() const             { return value[0]; }
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Fast approximations of the transcendental functions called per sample in the render loops.
+// Each one is branch-free (selects only, no table lookups and no libm calls), so a loop over
+// voice lanes that calls it still vectorizes. Max errors were measured against double-precision
+// libm over every float in the stated ranges (tools/fastmath checks them):
+//   exp2 (x)           relative 2.6e-7   x in [-126, 126] (clamped outside)
+//   log2 (x)           absolute 1.8e-7   x in [0.5, 2]; relative 1.4e-7 for other normal x > 0
+//   sin2Pi (cycles)    absolute 2.2e-7   cycles in [0, 1); periodic reduction is exact for |cycles| < 2^23
+//   tanh (x)           absolute 1.6e-7   all x
+//   tanhRational (x)   absolute 9.7e-5   all x: [7/6] Pade, clamped to +-5 like juce::dsp's tanh table
+// Build with NEON37_FAST_MATH=0 to route every call to libm instead, e.g. to A/B the output.
+#ifndef NEON37_FAST_MATH
+ #define NEON37_FAST_MATH 1
+#endif
+
+struct Neon37FastMath
+{
+#if NEON37_FAST_MATH
+    // 2^x: round to the nearest integer n (applied to the exponent bits) and evaluate
+    // 2^f = e^(f ln2) for f in [-0.5, 0.5] with a degree-6 Taylor polynomial
+    static inline float exp2 (float x) noexcept
+    {
+        x = std::min (std::max (x, -126.0f), 126.0f);
+        const float rounded = x + (x >= 0.0f ? 0.5f : -0.5f);
+        const int n = (int)rounded;
+        const float f = (x - (float)n) * 0.69314718056f;
+
+        const float p = 1.0f + f * (1.0f + f * (1.0f / 2.0f + f * (1.0f / 6.0f + f * (1.0f / 24.0f
+                      + f * (1.0f / 120.0f + f * (1.0f / 720.0f))))));
+
+        const int32_t scaleBits = (int32_t)((uint32_t)(n + 127) << 23);
+        float scale;
+        std::memcpy (&scale, &scaleBits, sizeof (scale));
+        return p * scale;
+    }
+
+    // log2(x) = exponent + log2(m), m in [sqrt(0.5), sqrt(2)), via the atanh series in
+    // t = (m - 1) / (m + 1), |t| < 0.172, to t^7
+    static inline float log2 (float x) noexcept
+    {
+        int32_t bits;
+        std::memcpy (&bits, &x, sizeof (bits));
+
+        // Re-bias the mantissa into [sqrt(0.5), sqrt(2)) (0x3f3504f3 is sqrt(0.5))
+        const int32_t offset = bits - 0x3f3504f3;
+        const int32_t exponent = offset >> 23;
+        const int32_t mantissaBits = bits - (int32_t)((uint32_t)exponent << 23);
+        float m;
+        std::memcpy (&m, &mantissaBits, sizeof (m));
+
+        const float t = (m - 1.0f) / (m + 1.0f);
+        const float t2 = t * t;
+        const float series = t * (2.0f + t2 * (2.0f / 3.0f + t2 * (2.0f / 5.0f + t2 * (2.0f / 7.0f))));
+        return (float)exponent + series * 1.44269504089f;
+    }
+
+    // sin(2 pi cycles): reduce to [-0.25, 0.25] cycles by periodicity and sin(pi - x) = sin(x),
+    // then an odd Taylor polynomial to x^11
+    static inline float sin2Pi (float cycles) noexcept
+    {
+        float r = cycles - (float)(int)cycles;     // (-1, 1)
+        r = r > 0.5f ? r - 1.0f : r;
+        r = r < -0.5f ? r + 1.0f : r;              // [-0.5, 0.5]
+        r = r > 0.25f ? 0.5f - r : r;
+        r = r < -0.25f ? -0.5f - r : r;            // [-0.25, 0.25]
+
+        const float x = r * 6.28318530718f;
+        const float x2 = x * x;
+        return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f
+                 + x2 * (1.0f / 362880.0f + x2 * (-1.0f / 39916800.0f))))));
+    }
+
+    // tanh(x) = (e^2x - 1) / (e^2x + 1), saturating at +-9 where tanh is 1 to within float precision
+    static inline float tanh (float x) noexcept
+    {
+        x = std::min (std::max (x, -9.0f), 9.0f);
+        const float e = exp2 (x * 2.88539008178f);  // 2 / ln 2
+        return (e - 1.0f) / (e + 1.0f);
+    }
+
+    // Cheaper tanh for saturation stages (filter drive): a [7/6] Pade approximant on [-5, 5]
+    static inline float tanhRational (float x) noexcept
+    {
+        x = std::min (std::max (x, -5.0f), 5.0f);
+        const float x2 = x * x;
+        const float numerator = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float denominator = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return std::min (std::max (numerator / denominator, -1.0f), 1.0f);
+    }
+#else
+    static inline float exp2 (float x) noexcept          { return std::exp2 (x); }
+    static inline float log2 (float x) noexcept          { return std::log2 (x); }
+    static inline float sin2Pi (float cycles) noexcept   { return std::sin (cycles * 6.28318530718f); }
+    static inline float tanh (float x) noexcept          { return std::tanh (x); }
+    static inline float tanhRational (float x) noexcept  { return std::tanh (x); }
+#endif
+};
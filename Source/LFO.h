@@ -0,0 +1,101 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+#include <cstdint>
+
+// Global LFO, rendered one value per sample so the modulation is the same whatever the host
+// block size. Sample i of a run is the waveform at phase + i * increment, evaluated by a
+// branch-free loop per waveform (the waveform is chosen once per run), so the loops vectorize.
+// The phase is accumulated in double: at 0.01 Hz and a high oversampled rate the per-sample
+// increment is below float resolution, and a float phase would stall.
+struct Neon37LFO
+{
+    enum Waveform : int { triangle = 0, rampUp, rampDown, square, sampleHold };
+
+    double phase = 0.0;           // 0-1 normalized phase
+    float rate = 0.1f;            // Hz (free mode) or tempo multiplier (sync mode)
+    int waveform = 0;             // 0=Triangle, 1=RampUp, 2=RampDown, 3=Square, 4=SampleHold
+    bool syncEnabled = false;
+
+    void advance (int numSamples, double sampleRate) noexcept
+    {
+        phase += (double)numSamples * (double)rate / sampleRate;
+        phase -= std::floor (phase);
+    }
+
+    // Write numSamples values (-1 to +1) starting at the current phase, then advance past them
+    void render (float* out, int numSamples, double sampleRate) noexcept
+    {
+        const float start = (float)phase;
+        const float increment = (float)((double)rate / sampleRate);
+
+        switch (waveform)
+        {
+            case triangle:
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = 4.0f * std::abs (phaseAt (start, increment, i) - 0.5f) - 1.0f;
+                break;
+
+            case rampUp:
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = 2.0f * phaseAt (start, increment, i) - 1.0f;
+                break;
+
+            case rampDown:
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = 1.0f - 2.0f * phaseAt (start, increment, i);
+                break;
+
+            case square:
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = phaseAt (start, increment, i) < 0.5f ? 1.0f : -1.0f;
+                break;
+
+            case sampleHold:
+            {
+                // Each step glides from the previous step's value over the first
+                // sampleHoldSlewSeconds (the whole step once steps get that short), so the held
+                // values do not click, and at audio rates the steps become a smooth random wave
+                const float slew = juce::jmin (1.0f, sampleHoldSlewSeconds * rate * (float)sampleHoldSteps);
+                const float slewScale = 1.0f / juce::jmax (slew, 1.0e-6f);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float position = phaseAt (start, increment, i) * (float)sampleHoldSteps;
+                    const int step = (int)position;
+                    const float held = sampleHoldValue (step);
+                    const float previous = sampleHoldValue (step - 1);
+                    const float t = juce::jmin (1.0f, (position - (float)step) * slewScale);
+                    out[i] = previous + (held - previous) * t;
+                }
+                break;
+            }
+
+            default:
+                juce::FloatVectorOperations::clear (out, numSamples);
+                break;
+        }
+
+        advance (numSamples, sampleRate);
+    }
+
+private:
+    static constexpr int sampleHoldSteps = 32;             // Random values per cycle
+    static constexpr float sampleHoldSlewSeconds = 0.001f;
+
+    static float phaseAt (float start, float increment, int sample) noexcept
+    {
+        const float p = start + increment * (float)sample;
+        return p - std::floor (p);
+    }
+
+    // Deterministic pseudo-random value (-1 to +1) for step index step of the cycle
+    static float sampleHoldValue (int step) noexcept
+    {
+        uint32_t seed = (uint32_t)(step & (sampleHoldSteps - 1)) * 2654435761U;
+        seed = seed ^ (seed >> 16);
+        seed = seed * 73856093U;
+        return ((float)(seed & 0x7FFF) / 32767.5f) - 1.0f;
+    }
+};
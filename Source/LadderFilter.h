@@ -0,0 +1,162 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "FastMath.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// 24 dB/oct transistor-ladder lowpass with drive, running numLanes independent filters side by side.
+// Same topology, drive curve and output level as juce::dsp::LadderFilter in LPF24 mode, without its
+// internal 50 ms parameter smoothers: cutoff and resonance targets are set once per control-rate
+// step and process() ramps linearly to them across the block it is given, so the ramp length is
+// exactly one control step.
+// Audio is interleaved by lane: frames[n * numLanes + lane]. The per-sample lane loop is branch-free
+// so it vectorizes across lanes (voices).
+template <int numLanes>
+class Neon37LadderFilter
+{
+public:
+    using LaneArray = std::array<float, numLanes>;
+
+    Neon37LadderFilter()
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            setResonance (lane, 0.0f);
+            setDrive (lane, 1.2f);
+        }
+        reset();
+    }
+
+    void prepare (double sampleRate)
+    {
+        jassert (sampleRate > 0.0);
+        cutoffFreqScaler = (float)(-juce::MathConstants<double>::twoPi / sampleRate * log2e);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+            setCutoffFrequencyHz (lane, cutoffHz[(size_t)lane]);
+
+        reset();
+    }
+
+    void setCutoffFrequencyHz (int lane, float newCutoffHz) noexcept
+    {
+        cutoffHz[(size_t)lane] = newCutoffHz;
+        targetCutoffTransform[(size_t)lane] = Neon37FastMath::exp2 (newCutoffHz * cutoffFreqScaler);
+    }
+
+    void setResonance (int lane, float newResonance) noexcept
+    {
+        targetScaledResonance[(size_t)lane] = juce::jmap (newResonance, 0.1f, 1.0f);
+    }
+
+    // Drive >= 1; takes effect immediately (not ramped)
+    void setDrive (int lane, float newDrive) noexcept
+    {
+        jassert (newDrive >= 1.0f);
+        const auto i = (size_t)lane;
+        if (newDrive == drive[i])
+            return;
+
+        drive[i] = newDrive;
+        gain[i] = std::pow (newDrive, -2.642f) * 0.6103f + 0.3903f;
+        drive2[i] = newDrive * 0.04f + 0.96f;
+        gain2[i] = std::pow (drive2[i], -2.642f) * 0.6103f + 0.3903f;
+    }
+
+    // Clear every lane's state and jump the coefficients to their targets
+    void reset() noexcept
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+            reset (lane);
+    }
+
+    void reset (int lane) noexcept
+    {
+        const auto i = (size_t)lane;
+        s0[i] = s1[i] = s2[i] = s3[i] = s4[i] = 0.0f;
+        cutoffTransform[i] = targetCutoffTransform[i];
+        scaledResonance[i] = targetScaledResonance[i];
+    }
+
+    // Filter numSamples interleaved frames in place, ramping every lane's coefficients to their targets
+    void process (float* frames, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        alignas (32) LaneArray cutoffStep, resonanceStep;
+        const float rampScale = 1.0f / (float)numSamples;
+        for (int i = 0; i < numLanes; ++i)
+        {
+            cutoffStep[(size_t)i] = (targetCutoffTransform[(size_t)i] - cutoffTransform[(size_t)i]) * rampScale;
+            resonanceStep[(size_t)i] = (targetScaledResonance[(size_t)i] - scaledResonance[(size_t)i]) * rampScale;
+        }
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* frame = frames + (size_t)n * numLanes;
+
+            for (int i = 0; i < numLanes; ++i)
+            {
+                const auto l = (size_t)i;
+                const float a1 = cutoffTransform[l] += cutoffStep[l];
+                const float resonance = scaledResonance[l] += resonanceStep[l];
+
+                const float g = 1.0f - a1;
+                const float b0 = g * 0.76923076923f;
+                const float b1 = g * 0.23076923076f;
+
+                const float dx = gain[l] * saturate (drive[l] * frame[i]);
+                const float a = dx - 4.0f * resonance * (gain2[l] * saturate (drive2[l] * s4[l]) - dx * 0.5f);
+
+                const float b = b1 * s0[l] + a1 * s1[l] + b0 * a;
+                const float c = b1 * s1[l] + a1 * s2[l] + b0 * b;
+                const float d = b1 * s2[l] + a1 * s3[l] + b0 * c;
+                const float e = b1 * s3[l] + a1 * s4[l] + b0 * d;
+
+                s0[l] = a;
+                s1[l] = b;
+                s2[l] = c;
+                s3[l] = d;
+                s4[l] = e;
+
+                frame[i] = e * outputGain;
+            }
+        }
+
+        // Land exactly on the targets (no drift from accumulated steps)
+        cutoffTransform = targetCutoffTransform;
+        scaledResonance = targetScaledResonance;
+    }
+
+private:
+    static constexpr float outputGain = 1.2f;
+
+    // tanh clamped to [-5, 5] like JUCE's lookup table, without the table (see FastMath.h for the error)
+    static inline float saturate (float x) noexcept
+    {
+        return Neon37FastMath::tanhRational (x);
+    }
+
+    // Cutoff transform exp(-2 pi fc / sr) evaluated as exp2, so the scaler carries log2(e)
+    static constexpr double log2e = 1.4426950408889634;
+    float cutoffFreqScaler = (float)(-juce::MathConstants<double>::twoPi / 44100.0 * log2e);
+
+    // Ladder stage state (s0 is the feedback-summed input)
+    alignas (32) LaneArray s0{}, s1{}, s2{}, s3{}, s4{};
+
+    // Coefficients: current (ramping) and target per lane
+    alignas (32) LaneArray cutoffTransform{}, targetCutoffTransform{};
+    alignas (32) LaneArray scaledResonance{}, targetScaledResonance{};
+    alignas (32) LaneArray drive{}, gain{}, drive2{}, gain2{};
+    LaneArray cutoffHz = filledWith (1000.0f);
+
+    static LaneArray filledWith (float value)
+    {
+        LaneArray values;
+        values.fill (value);
+        return values;
+    }
+};
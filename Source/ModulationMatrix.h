@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Modulation routing as a flat list of (source, destination, amount) routes. The amounts come
+// from the per-pair parameters (vel_pitch, lfo1_filter, ...); Neon37DerivedParameters compiles
+// them only when one of those parameters changed, keeping just the routes with a non-zero amount
+// in source order. The audio thread walks that short list, so an unused routing costs nothing,
+// and a new source or destination is one more enum entry and one more add() in the compile step.
+struct Neon37ModulationMatrix
+{
+    enum Source : int
+    {
+        lfo1 = 0, lfo2,          // Rendered per sample (-1 to +1)
+        velocity, aftertouch,    // Per note in Poly, otherwise the last note / channel pressure (0-1)
+        modWheel, pitchBend,     // Channel controllers (0 to 1, -1 to +1)
+        pitchEnvelope,           // Per voice, per sample (0-1), applied in the oscillator loops
+        numSources
+    };
+
+    enum Destination : int
+    {
+        pitch = 0,               // Semitones, both oscillators
+        osc1Pitch, osc2Pitch,    // Semitones, one oscillator
+        cutoff,                  // Cutoff multiplier offset (cutoff * (1 + total))
+        amp,                     // Amplitude multiplier offset (gain * (1 + total))
+        numDestinations
+    };
+
+    struct Route
+    {
+        Source source;
+        Destination destination;
+        float amount;
+    };
+
+    using SourceValues = std::array<float, numSources>;
+    using DestinationValues = std::array<float, numDestinations>;
+
+    using SourceMask = uint32_t;
+    static constexpr SourceMask maskOf (Source source) { return 1u << (uint32_t)source; }
+    static constexpr SourceMask noteSources = (1u << velocity) | (1u << aftertouch);
+    static constexpr SourceMask channelSources = (1u << modWheel) | (1u << pitchBend);
+
+    // Compile step: clear, then add every route in source order (zero amounts are dropped)
+    void clear() noexcept
+    {
+        numRoutes = 0;
+        routedSources = 0;
+    }
+
+    void add (Source source, Destination destination, float amount) noexcept
+    {
+        if (amount == 0.0f || numRoutes == (int)routes.size())
+            return;
+
+        routes[(std::size_t)numRoutes++] = { source, destination, amount };
+        routedSources |= maskOf (source);
+    }
+
+    const Route* begin() const noexcept { return routes.data(); }
+    const Route* end() const noexcept   { return routes.data() + numRoutes; }
+    int getNumRoutes() const noexcept   { return numRoutes; }
+
+    bool isRouted (Source source) const noexcept { return (routedSources & maskOf (source)) != 0; }
+
+    // Add amount * value to out[destination] for every route whose source is in sources
+    void accumulate (const SourceValues& values, SourceMask sources, DestinationValues& out) const noexcept
+    {
+        for (const auto& route : *this)
+        {
+            if ((sources & maskOf (route.source)) != 0)
+                out[(std::size_t)route.destination] += route.amount * values[(std::size_t)route.source];
+        }
+    }
+
+    // Total amount from source to destination (for sources applied in their own per-sample loops)
+    float getAmount (Source source, Destination destination) const noexcept
+    {
+        float amount = 0.0f;
+        for (const auto& route : *this)
+        {
+            if (route.source == source && route.destination == destination)
+                amount += route.amount;
+        }
+        return amount;
+    }
+
+private:
+    std::array<Route, (std::size_t)numSources * (std::size_t)numDestinations> routes{};
+    int numRoutes = 0;
+    SourceMask routedSources = 0;
+};
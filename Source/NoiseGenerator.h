@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// White noise from numLanes independent xorshift32 streams stepped side by side.
+// One step produces a frame of numLanes values (one per lane); the lane loop is shifts and xors
+// only, so it vectorizes. Used two ways:
+//  - per-voice noise: one frame per sample, lane v is voice v's own stream
+//  - block noise: fill() writes consecutive frames into a flat buffer, so one mono block of
+//    noise comes out of numLanes streams at SIMD width
+// Every stream is derived from an explicit seed, so the output is reproducible across renders.
+template <int numLanes>
+class Neon37NoiseGenerator
+{
+public:
+    Neon37NoiseGenerator() { seed (1); }
+
+    // Restart every stream from seedValue (lanes get distinct, non-zero states)
+    void seed (uint32_t seedValue) noexcept
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            // lowbias32 hash of the seed and lane index; xorshift needs a non-zero state
+            uint32_t h = seedValue + 0x9e3779b9u * (uint32_t)(lane + 1);
+            h ^= h >> 16;
+            h *= 0x7feb352du;
+            h ^= h >> 15;
+            h *= 0x846ca68bu;
+            h ^= h >> 16;
+            state[(size_t)lane] = h != 0 ? h : 0x6d2b79f5u;
+        }
+    }
+
+    // Step every lane once, writing one value per lane in [-1, 1)
+    void next (float* out) noexcept
+    {
+        for (int i = 0; i < numLanes; ++i)
+        {
+            uint32_t x = state[(size_t)i];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            state[(size_t)i] = x;
+            out[i] = (float)(int32_t)x * (1.0f / 2147483648.0f);
+        }
+    }
+
+    // Fill numValues consecutive values (whole frames, then a partial one)
+    void fill (float* out, int numValues) noexcept
+    {
+        int n = 0;
+        for (; n + numLanes <= numValues; n += numLanes)
+            next (out + n);
+
+        if (n < numValues)
+        {
+            alignas (32) std::array<float, numLanes> frame;
+            next (frame.data());
+            for (int i = 0; n < numValues; ++i, ++n)
+                out[n] = frame[(size_t)i];
+        }
+    }
+
+private:
+    alignas (32) std::array<uint32_t, numLanes> state{};
+};
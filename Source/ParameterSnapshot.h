@@ -0,0 +1,510 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "ModulationMatrix.h"
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <initializer_list>
+
+// Every parameter from createParameterLayout, in layout order: X (enumName, "apvts_id")
+// Add new parameters here as well as in createParameterLayout (the table asserts they match).
+#define NEON37_PARAMETER_LIST(X) \
+    X (masterVolume,     "master_volume") \
+    X (masterTune,       "master_tune") \
+    X (osc1Wave,         "osc1_wave") \
+    X (osc1Octave,       "osc1_octave") \
+    X (osc1Semitones,    "osc1_semitones") \
+    X (osc1Fine,         "osc1_fine") \
+    X (osc2Wave,         "osc2_wave") \
+    X (osc2Octave,       "osc2_octave") \
+    X (osc2Semitones,    "osc2_semitones") \
+    X (osc2Fine,         "osc2_fine") \
+    X (oscFreq,          "osc_freq") \
+    X (oscBeat,          "osc_beat") \
+    X (hardSync,         "hard_sync") \
+    X (oscEngine,        "osc_engine") \
+    X (osc1Morph,        "osc1_morph") \
+    X (osc2Morph,        "osc2_morph") \
+    X (mixerOsc1,        "mixer_osc1") \
+    X (mixerSub1,        "mixer_sub1") \
+    X (mixerOsc2,        "mixer_osc2") \
+    X (mixerNoise,       "mixer_noise") \
+    X (mixerReturn,      "mixer_return") \
+    X (cutoff,           "cutoff") \
+    X (resonance,        "resonance") \
+    X (drive,            "drive") \
+    X (egDepth,          "eg_depth") \
+    X (keyTrack,         "key_track") \
+    X (env1Attack,       "env1_attack") \
+    X (env1Decay,        "env1_decay") \
+    X (env1Sustain,      "env1_sustain") \
+    X (env1Release,      "env1_release") \
+    X (env2Attack,       "env2_attack") \
+    X (env2Decay,        "env2_decay") \
+    X (env2Sustain,      "env2_sustain") \
+    X (env2Release,      "env2_release") \
+    X (envExpCurve,      "env_exp_curv") \
+    X (envPitchAttack,   "env_pitch_attack") \
+    X (envPitchDecay,    "env_pitch_decay") \
+    X (envPitchSustain,  "env_pitch_sustain") \
+    X (envPitchRelease,  "env_pitch_release") \
+    X (envPitchDepth,    "env_pitch_depth") \
+    X (envPitchTarget,   "env_pitch_target") \
+    X (arpOn,            "arp_on") \
+    X (voiceMode,        "voice_mode") \
+    X (holdMode,         "hold_mode") \
+    X (glideTime,        "glide_time") \
+    X (glideRate,        "glide_rate") \
+    X (glideLegato,      "glide_legato") \
+    X (lfo1Rate,         "lfo1_rate") \
+    X (lfo1Sync,         "lfo1_sync") \
+    X (lfo1SyncVal,      "lfo1_sync_val") \
+    X (lfo1KeyReset,     "lfo1_key_reset") \
+    X (lfo1Wave,         "lfo1_wave") \
+    X (lfo1Pitch,        "lfo1_pitch") \
+    X (lfo1Filter,       "lfo1_filter") \
+    X (lfo1Amp,          "lfo1_amp") \
+    X (lfo2Rate,         "lfo2_rate") \
+    X (lfo2Sync,         "lfo2_sync") \
+    X (lfo2SyncVal,      "lfo2_sync_val") \
+    X (lfo2KeyReset,     "lfo2_key_reset") \
+    X (lfo2Wave,         "lfo2_wave") \
+    X (lfo2Pitch,        "lfo2_pitch") \
+    X (lfo2Filter,       "lfo2_filter") \
+    X (lfo2Amp,          "lfo2_amp") \
+    X (velPitch,         "vel_pitch") \
+    X (velFilter,        "vel_filter") \
+    X (velAmp,           "vel_amp") \
+    X (atPitch,          "at_pitch") \
+    X (atFilter,         "at_filter") \
+    X (atAmp,            "at_amp") \
+    X (pbPitch,          "pb_pitch") \
+    X (pbFilter,         "pb_filter") \
+    X (pbAmp,            "pb_amp") \
+    X (mwPitch,          "mw_pitch") \
+    X (mwFilter,         "mw_filter") \
+    X (mwAmp,            "mw_amp") \
+    X (mwEnable,         "mw_enable") \
+    X (lfo1Mw,           "lfo1_mw") \
+    X (lfo2Mw,           "lfo2_mw") \
+    X (hqMode,           "hq_mode") \
+    X (voiceCount,       "voice_count") \
+    X (voiceSteal,       "voice_steal") \
+    X (cullFloor,        "cull_floor") \
+    X (polyThreads,      "poly_threads") \
+    X (renderAhead,      "render_ahead") \
+    X (unisonVoices,     "unison_voices") \
+    X (unisonDetune,     "unison_detune") \
+    X (unisonSpread,     "unison_spread")
+
+// Compile-time parameter index
+enum class Neon37Param : int
+{
+   #define NEON37_PARAMETER_ENUM(name, id) name,
+    NEON37_PARAMETER_LIST (NEON37_PARAMETER_ENUM)
+   #undef NEON37_PARAMETER_ENUM
+    numParameters
+};
+
+inline const char* getParameterID (Neon37Param param)
+{
+    static constexpr const char* ids[] =
+    {
+       #define NEON37_PARAMETER_ID(name, id) id,
+        NEON37_PARAMETER_LIST (NEON37_PARAMETER_ID)
+       #undef NEON37_PARAMETER_ID
+    };
+
+    return ids[(int)param];
+}
+
+// Set of parameters (indexed by Neon37Param) that changed since the previous block
+using Neon37ParamSet = std::bitset<(size_t)Neon37Param::numParameters>;
+
+inline bool anyChanged (const Neon37ParamSet& changed, std::initializer_list<Neon37Param> inputs)
+{
+    for (auto param : inputs)
+        if (changed[(size_t)param])
+            return true;
+    return false;
+}
+
+// Typed copy of every parameter value, taken once at the top of each block.
+// Render code reads only this struct (no string lookups, no atomics in the hot loops).
+struct Neon37ParameterSnapshot
+{
+    // Master
+    float masterVolumeDb = 0.0f, masterTune = 440.0f;
+
+    // Oscillators
+    int osc1Wave = 2, osc1Octave = 0, osc1Semitones = 0;
+    float osc1Fine = 0.0f;
+    int osc2Wave = 2, osc2Octave = 0, osc2Semitones = 0;
+    float osc2Fine = 0.0f;
+    float oscFreq = 0.0f, oscBeat = 0.0f;
+    bool hardSync = false;
+    int oscEngine = 0;  // 0: PolyBLEP, 1: Wavetable
+    float osc1Morph = 0.0f, osc2Morph = 0.0f;
+    int unisonVoices = 1;  // Detuned copies of the oscillator set per voice (1-8)
+    float unisonDetune = 20.0f;  // Cents between the outermost copy and the voice pitch
+    float unisonSpread = 1.0f;  // Start phases of the copies at note-on, spread over this fraction of a cycle
+
+    // Mixer (dB)
+    float mixerOsc1Db = 0.0f, mixerSub1Db = -60.0f, mixerOsc2Db = -60.0f, mixerNoiseDb = -60.0f, mixerReturnDb = -60.0f;
+
+    // Filter
+    float cutoff = 20000.0f, resonance = 0.0f, drive = 1.0f, egDepth = 0.0f, keyTrack = 0.0f;
+
+    // Envelopes (seconds / 0-1 sustain)
+    float env1Attack = 0.001f, env1Decay = 0.05f, env1Sustain = 1.0f, env1Release = 0.05f;
+    float env2Attack = 0.003f, env2Decay = 0.05f, env2Sustain = 1.0f, env2Release = 0.05f;
+    bool envExpCurve = true;
+    float envPitchAttack = 0.001f, envPitchDecay = 0.05f, envPitchSustain = 0.0f, envPitchRelease = 0.05f;
+    float envPitchDepth = 0.0f;
+    int envPitchTarget = 1;  // 0: Osc1, 1: Both, 2: Osc2
+
+    // Voice / arp / glide
+    bool arpOn = false;
+    int voiceMode = 0;  // 0: Mono-L, 1: Mono, 2: Para-L, 3: Para, 4: Poly
+    int voiceCount = 8;  // Para/Poly polyphony (1-64)
+    int voiceSteal = 0;  // 0: Oldest, 1: Quietest, 2: Releasing First
+    float cullFloorDb = -96.0f;  // Amp envelope level below which a fading voice is stopped
+    int polyThreads = 0;  // Poly rendering threads: 0: Off, 1: 2, 2: 4, 3: 8
+    int renderAhead = 0;  // Render-ahead chunk: 0: Off, 1: 256, 2: 512, 3: 1024 samples
+    bool holdMode = false;
+    float glideTimeMs = 0.0f;
+    bool glideRate = true, glideLegato = false;
+
+    // LFOs
+    float lfo1Rate = 0.1f;
+    bool lfo1Sync = false;
+    int lfo1SyncVal = 0;
+    bool lfo1KeyReset = false;
+    int lfo1Wave = 0;
+    float lfo1Pitch = 0.0f, lfo1Filter = 0.0f, lfo1Amp = 0.0f;
+    float lfo2Rate = 0.1f;
+    bool lfo2Sync = false;
+    int lfo2SyncVal = 0;
+    bool lfo2KeyReset = false;
+    int lfo2Wave = 0;
+    float lfo2Pitch = 0.0f, lfo2Filter = 0.0f, lfo2Amp = 0.0f;
+
+    // Velocity / aftertouch / pitch bend / mod wheel amounts
+    float velPitch = 0.0f, velFilter = 0.0f, velAmp = 0.0f;
+    float atPitch = 0.0f, atFilter = 0.0f, atAmp = 0.0f;
+    float pbPitch = 2.0f, pbFilter = 0.0f, pbAmp = 0.0f;
+    float mwPitch = 0.0f, mwFilter = 0.0f, mwAmp = 0.0f;
+    bool mwEnable = false, lfo1Mw = false, lfo2Mw = false;
+
+    // Render quality
+    int hqMode = 0;  // Oversampling order: 0: Off, 1: 2x, 2: 4x, 3: 8x
+};
+
+// Raw parameter handles, resolved once at construction and indexed by Neon37Param.
+// Each parameter also has a generation counter, bumped by an APVTS listener whenever its value
+// changes, so the audio thread can tell which parameters moved without comparing values.
+class Neon37ParameterTable
+{
+public:
+    ~Neon37ParameterTable()
+    {
+        if (attachedTo != nullptr)
+            for (int i = 0; i < (int)Neon37Param::numParameters; ++i)
+                attachedTo->removeParameterListener (getParameterID ((Neon37Param)i), &listeners[(size_t)i]);
+    }
+
+    void resolve (juce::AudioProcessorValueTreeState& apvts)
+    {
+        for (int i = 0; i < (int)Neon37Param::numParameters; ++i)
+        {
+            handles[(size_t)i] = apvts.getRawParameterValue (getParameterID ((Neon37Param)i));
+            jassert (handles[(size_t)i] != nullptr);  // NEON37_PARAMETER_LIST out of sync with createParameterLayout
+
+            listeners[(size_t)i].totalGeneration = &totalGeneration;
+            apvts.addParameterListener (getParameterID ((Neon37Param)i), &listeners[(size_t)i]);
+        }
+
+        attachedTo = &apvts;
+    }
+
+    // Report every parameter as changed on the next update (e.g. after prepareToPlay)
+    void markAllChanged() { forceAllChanged = true; }
+
+    // Collect the parameters whose generation moved since the last call and refresh the snapshot.
+    // Returns false (and does no work) when nothing changed, which is the steady state.
+    bool update (Neon37ParameterSnapshot& snapshot, Neon37ParamSet& changed)
+    {
+        changed.reset();
+
+        const auto total = totalGeneration.load (std::memory_order_acquire);
+        if (total == seenTotalGeneration && ! forceAllChanged)
+            return false;
+
+        seenTotalGeneration = total;
+
+        for (size_t i = 0; i < (size_t)Neon37Param::numParameters; ++i)
+        {
+            const auto generation = listeners[i].generation.load (std::memory_order_acquire);
+            if (generation != seenGenerations[i] || forceAllChanged)
+            {
+                seenGenerations[i] = generation;
+                changed.set (i);
+            }
+        }
+
+        forceAllChanged = false;
+        fillSnapshot (snapshot);
+        return true;
+    }
+
+    float get (Neon37Param param) const  { return handles[(size_t)param]->load (std::memory_order_relaxed); }
+    int getInt (Neon37Param param) const { return (int)get (param); }
+    bool getBool (Neon37Param param) const { return get (param) > 0.5f; }
+
+    void fillSnapshot (Neon37ParameterSnapshot& s) const
+    {
+        using P = Neon37Param;
+
+        s.masterVolumeDb = get (P::masterVolume);
+        s.masterTune = get (P::masterTune);
+
+        s.osc1Wave = getInt (P::osc1Wave);
+        s.osc1Octave = getInt (P::osc1Octave);
+        s.osc1Semitones = getInt (P::osc1Semitones);
+        s.osc1Fine = get (P::osc1Fine);
+        s.osc2Wave = getInt (P::osc2Wave);
+        s.osc2Octave = getInt (P::osc2Octave);
+        s.osc2Semitones = getInt (P::osc2Semitones);
+        s.osc2Fine = get (P::osc2Fine);
+        s.oscFreq = get (P::oscFreq);
+        s.oscBeat = get (P::oscBeat);
+        s.hardSync = getBool (P::hardSync);
+        s.oscEngine = getInt (P::oscEngine);
+        s.osc1Morph = get (P::osc1Morph);
+        s.osc2Morph = get (P::osc2Morph);
+
+        s.mixerOsc1Db = get (P::mixerOsc1);
+        s.mixerSub1Db = get (P::mixerSub1);
+        s.mixerOsc2Db = get (P::mixerOsc2);
+        s.mixerNoiseDb = get (P::mixerNoise);
+        s.mixerReturnDb = get (P::mixerReturn);
+
+        s.cutoff = get (P::cutoff);
+        s.resonance = get (P::resonance);
+        s.drive = get (P::drive);
+        s.egDepth = get (P::egDepth);
+        s.keyTrack = get (P::keyTrack);
+
+        s.env1Attack = get (P::env1Attack);
+        s.env1Decay = get (P::env1Decay);
+        s.env1Sustain = get (P::env1Sustain);
+        s.env1Release = get (P::env1Release);
+        s.env2Attack = get (P::env2Attack);
+        s.env2Decay = get (P::env2Decay);
+        s.env2Sustain = get (P::env2Sustain);
+        s.env2Release = get (P::env2Release);
+        s.envExpCurve = getBool (P::envExpCurve);
+        s.envPitchAttack = get (P::envPitchAttack);
+        s.envPitchDecay = get (P::envPitchDecay);
+        s.envPitchSustain = get (P::envPitchSustain);
+        s.envPitchRelease = get (P::envPitchRelease);
+        s.envPitchDepth = get (P::envPitchDepth);
+        s.envPitchTarget = getInt (P::envPitchTarget);
+
+        s.arpOn = getBool (P::arpOn);
+        s.voiceMode = getInt (P::voiceMode);
+        s.holdMode = getBool (P::holdMode);
+        s.glideTimeMs = get (P::glideTime);
+        s.glideRate = getBool (P::glideRate);
+        s.glideLegato = getBool (P::glideLegato);
+
+        s.lfo1Rate = get (P::lfo1Rate);
+        s.lfo1Sync = getBool (P::lfo1Sync);
+        s.lfo1SyncVal = getInt (P::lfo1SyncVal);
+        s.lfo1KeyReset = getBool (P::lfo1KeyReset);
+        s.lfo1Wave = getInt (P::lfo1Wave);
+        s.lfo1Pitch = get (P::lfo1Pitch);
+        s.lfo1Filter = get (P::lfo1Filter);
+        s.lfo1Amp = get (P::lfo1Amp);
+        s.lfo2Rate = get (P::lfo2Rate);
+        s.lfo2Sync = getBool (P::lfo2Sync);
+        s.lfo2SyncVal = getInt (P::lfo2SyncVal);
+        s.lfo2KeyReset = getBool (P::lfo2KeyReset);
+        s.lfo2Wave = getInt (P::lfo2Wave);
+        s.lfo2Pitch = get (P::lfo2Pitch);
+        s.lfo2Filter = get (P::lfo2Filter);
+        s.lfo2Amp = get (P::lfo2Amp);
+
+        s.velPitch = get (P::velPitch);
+        s.velFilter = get (P::velFilter);
+        s.velAmp = get (P::velAmp);
+        s.atPitch = get (P::atPitch);
+        s.atFilter = get (P::atFilter);
+        s.atAmp = get (P::atAmp);
+        s.pbPitch = get (P::pbPitch);
+        s.pbFilter = get (P::pbFilter);
+        s.pbAmp = get (P::pbAmp);
+        s.mwPitch = get (P::mwPitch);
+        s.mwFilter = get (P::mwFilter);
+        s.mwAmp = get (P::mwAmp);
+        s.mwEnable = getBool (P::mwEnable);
+        s.lfo1Mw = getBool (P::lfo1Mw);
+        s.lfo2Mw = getBool (P::lfo2Mw);
+
+        s.hqMode = getInt (P::hqMode);
+        s.voiceCount = getInt (P::voiceCount);
+        s.voiceSteal = getInt (P::voiceSteal);
+        s.cullFloorDb = get (P::cullFloor);
+        s.polyThreads = getInt (P::polyThreads);
+        s.renderAhead = getInt (P::renderAhead);
+        s.unisonVoices = getInt (P::unisonVoices);
+        s.unisonDetune = get (P::unisonDetune);
+        s.unisonSpread = get (P::unisonSpread);
+    }
+
+private:
+    // Bumps one parameter's generation (called on whichever thread changed the parameter)
+    struct GenerationListener : public juce::AudioProcessorValueTreeState::Listener
+    {
+        void parameterChanged (const juce::String&, float) override
+        {
+            generation.fetch_add (1, std::memory_order_release);
+            totalGeneration->fetch_add (1, std::memory_order_release);
+        }
+
+        std::atomic<uint32_t> generation { 0 };
+        std::atomic<uint32_t>* totalGeneration = nullptr;
+    };
+
+    std::array<std::atomic<float>*, (size_t)Neon37Param::numParameters> handles{};
+    std::array<GenerationListener, (size_t)Neon37Param::numParameters> listeners;
+    std::atomic<uint32_t> totalGeneration { 0 };
+
+    // Audio-thread side: generations seen at the last update
+    std::array<uint32_t, (size_t)Neon37Param::numParameters> seenGenerations{};
+    uint32_t seenTotalGeneration = 0;
+    bool forceAllChanged = true;
+
+    juce::AudioProcessorValueTreeState* attachedTo = nullptr;
+};
+
+// Quantities derived from parameters (pow/dB conversions, envelope settings), recomputed only
+// when one of their inputs changed. The *Changed flags tell the processor which envelopes to
+// push new parameters to this block.
+struct Neon37DerivedParameters
+{
+    // Global oscillator level scaling to prevent overdrive (-12dB to keep headroom)
+    static constexpr float oscLevelScale = 0.25f;
+
+    // Oscillator tuning offsets in octaves (octave + semitones + fine), added to the log2 pitch
+    float osc1Octaves = 0.0f, osc2Octaves = 0.0f;
+
+    // Linear mixer gains (including oscLevelScale) and master volume
+    float mixerOsc1 = 0.0f, mixerOsc2 = 0.0f, mixerSub1 = 0.0f, mixerNoise = 0.0f;
+    float masterVol = 1.0f;
+
+    // Linear amp envelope level below which a fading voice (or the shared envelope) is culled
+    float cullFloor = 0.0f;
+
+    // Unison: copies in use, each copy's pitch offset in octaves (evenly from -detune to +detune)
+    // and its mix gain (1 / sqrt(copies), so the stack keeps the level of one voice; 0 for unused copies)
+    static constexpr int maxUnison = 8;
+    int unisonCount = 1;
+    std::array<float, maxUnison> unisonOctaves{}, unisonGains{};
+
+    // Modulation routes with a non-zero amount (LFO, velocity, aftertouch, mod wheel, bend, pitch envelope)
+    Neon37ModulationMatrix modMatrix;
+
+    // Envelope settings (env_exp_curv selects exponential segments for all of them)
+    juce::ADSR::Parameters filterEnv, ampEnv, pitchEnv;
+    bool envExponential = true;
+    bool filterEnvChanged = false, ampEnvChanged = false, pitchEnvChanged = false;
+
+    void update (const Neon37ParameterSnapshot& p, const Neon37ParamSet& changed)
+    {
+        using P = Neon37Param;
+
+        if (anyChanged (changed, { P::osc1Octave, P::osc1Semitones, P::osc1Fine }))
+            osc1Octaves = (float)p.osc1Octave + ((float)p.osc1Semitones + p.osc1Fine) / 12.0f;
+
+        if (anyChanged (changed, { P::osc2Octave, P::osc2Semitones, P::osc2Fine }))
+            osc2Octaves = (float)p.osc2Octave + ((float)p.osc2Semitones + p.osc2Fine) / 12.0f;
+
+        if (changed[(size_t)P::mixerOsc1])   mixerOsc1 = juce::Decibels::decibelsToGain (p.mixerOsc1Db) * oscLevelScale;
+        if (changed[(size_t)P::mixerOsc2])   mixerOsc2 = juce::Decibels::decibelsToGain (p.mixerOsc2Db) * oscLevelScale;
+        if (changed[(size_t)P::mixerSub1])   mixerSub1 = juce::Decibels::decibelsToGain (p.mixerSub1Db) * oscLevelScale;
+        if (changed[(size_t)P::mixerNoise])  mixerNoise = juce::Decibels::decibelsToGain (p.mixerNoiseDb) * oscLevelScale;
+        if (changed[(size_t)P::masterVolume]) masterVol = juce::Decibels::decibelsToGain (p.masterVolumeDb);
+        if (changed[(size_t)P::cullFloor])   cullFloor = juce::Decibels::decibelsToGain (p.cullFloorDb);
+
+        if (anyChanged (changed, { P::unisonVoices, P::unisonDetune }))
+        {
+            unisonCount = juce::jlimit (1, maxUnison, p.unisonVoices);
+            const float gain = 1.0f / std::sqrt ((float)unisonCount);
+            for (int i = 0; i < maxUnison; ++i)
+            {
+                const float position = unisonCount > 1 ? 2.0f * (float)i / (float)(unisonCount - 1) - 1.0f : 0.0f;
+                unisonOctaves[(size_t)i] = i < unisonCount ? position * p.unisonDetune / 1200.0f : 0.0f;
+                unisonGains[(size_t)i] = i < unisonCount ? gain : 0.0f;
+            }
+        }
+
+        if (anyChanged (changed, { P::lfo1Pitch, P::lfo1Filter, P::lfo1Amp, P::lfo2Pitch, P::lfo2Filter, P::lfo2Amp,
+                                   P::velPitch, P::velFilter, P::velAmp, P::atPitch, P::atFilter, P::atAmp,
+                                   P::mwPitch, P::mwFilter, P::mwAmp, P::pbPitch, P::pbFilter, P::pbAmp,
+                                   P::envPitchDepth, P::envPitchTarget }))
+            compileModulationMatrix (p);
+
+        envExponential = p.envExpCurve;
+
+        filterEnvChanged = anyChanged (changed, { P::env1Attack, P::env1Decay, P::env1Sustain, P::env1Release, P::envExpCurve });
+        if (filterEnvChanged)
+            filterEnv = { p.env1Attack, p.env1Decay, p.env1Sustain, p.env1Release };
+
+        ampEnvChanged = anyChanged (changed, { P::env2Attack, P::env2Decay, P::env2Sustain, P::env2Release, P::envExpCurve });
+        if (ampEnvChanged)
+            ampEnv = { p.env2Attack, p.env2Decay, p.env2Sustain, p.env2Release };
+
+        pitchEnvChanged = anyChanged (changed, { P::envPitchAttack, P::envPitchDecay, P::envPitchSustain, P::envPitchRelease, P::envExpCurve });
+        if (pitchEnvChanged)
+            pitchEnv = { p.envPitchAttack, p.envPitchDecay, p.envPitchSustain, p.envPitchRelease };
+    }
+
+    // Clear the *Changed flags once the processor has pushed them
+    void clearChangeFlags() { filterEnvChanged = ampEnvChanged = pitchEnvChanged = false; }
+
+private:
+    void compileModulationMatrix (const Neon37ParameterSnapshot& p)
+    {
+        using M = Neon37ModulationMatrix;
+        modMatrix.clear();
+
+        // LFO pitch amounts are 0-1 of an octave
+        modMatrix.add (M::lfo1, M::pitch, p.lfo1Pitch * 12.0f);
+        modMatrix.add (M::lfo1, M::cutoff, p.lfo1Filter);
+        modMatrix.add (M::lfo1, M::amp, p.lfo1Amp);
+        modMatrix.add (M::lfo2, M::pitch, p.lfo2Pitch * 12.0f);
+        modMatrix.add (M::lfo2, M::cutoff, p.lfo2Filter);
+        modMatrix.add (M::lfo2, M::amp, p.lfo2Amp);
+
+        modMatrix.add (M::velocity, M::pitch, p.velPitch);
+        modMatrix.add (M::velocity, M::cutoff, p.velFilter);
+        modMatrix.add (M::velocity, M::amp, p.velAmp);
+        modMatrix.add (M::aftertouch, M::pitch, p.atPitch);
+        modMatrix.add (M::aftertouch, M::cutoff, p.atFilter);
+        modMatrix.add (M::aftertouch, M::amp, p.atAmp);
+        modMatrix.add (M::modWheel, M::pitch, p.mwPitch);
+        modMatrix.add (M::modWheel, M::cutoff, p.mwFilter);
+        modMatrix.add (M::modWheel, M::amp, p.mwAmp);
+        modMatrix.add (M::pitchBend, M::pitch, p.pbPitch);
+        modMatrix.add (M::pitchBend, M::cutoff, p.pbFilter);
+        modMatrix.add (M::pitchBend, M::amp, p.pbAmp);
+
+        // env_pitch_target: 0: Osc1, 1: Both, 2: Osc2
+        if (p.envPitchTarget == 0 || p.envPitchTarget == 1)
+            modMatrix.add (M::pitchEnvelope, M::osc1Pitch, p.envPitchDepth);
+        if (p.envPitchTarget == 2 || p.envPitchTarget == 1)
+            modMatrix.add (M::pitchEnvelope, M::osc2Pitch, p.envPitchDepth);
+    }
+};
@@ -1,5 +1,7 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "RealtimeCheck.h"
+#include "PolyBLEPOscillator.h"
 
 Neon37AudioProcessor::Neon37AudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -16,10 +18,26 @@ Neon37AudioProcessor::Neon37AudioProcessor()
 #endif
     apvts (*this, nullptr, "Parameters", createParameterLayout())
 {
+    // Resolve every parameter handle once (render code reads the per-block snapshot instead)
+    parameterTable.resolve(apvts);
+    parameterTable.fillSnapshot(params);
+
+    // Note stack never holds more than 128 unique notes; reserve up front so note-ons never allocate
+    noteStack.reserve(128);
+
+    // Shared wavetables are built by the first instance (here, never on the audio thread)
+    wavetables = &Neon37WavetableBank::getShared();
+
+    // Watch for HQ mode changes, which need new buffers and so can't be applied in processBlock
+    startTimerHz(4);
 }
 
 Neon37AudioProcessor::~Neon37AudioProcessor()
 {
+    stopTimer();
+    
+    // The render-ahead worker drives the engine, so it goes before any engine state
+    renderAhead.stop();
 }
 
 const juce::String Neon37AudioProcessor::getName() const
@@ -56,7 +74,9 @@ bool Neon37AudioProcessor::isMidiEffect() const
 
 double Neon37AudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // After the last note-off the output lasts for the amp envelope's release: linear or
+    // exponential, the release is built to reach 0 at exactly env2_release
+    return (double)parameterTable.get(Neon37Param::env2Release);
 }
 
 int Neon37AudioProcessor::getNumPrograms()
@@ -87,132 +107,157 @@ void Neon37AudioProcessor::changeProgramName (int index, const juce::String& new
 
 void Neon37AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    currentSampleRate = sampleRate;
+    // No render-ahead worker may touch the engine while it is being prepared
+    renderAhead.stop();
+    
+    // Refresh the snapshot and recompute every derived value from scratch
+    Neon37ParamSet changedParams;
+    parameterTable.markAllChanged();
+    parameterTable.update(params, changedParams);
+    derived.update(params, changedParams);
+    derived.clearChangeFlags();  // Envelopes are initialised below
+    
+    // HQ mode: everything below runs at the engine rate (host rate x oversampling factor)
+    oversamplingOrder = juce::jlimit(0, 3, params.hqMode);
+    oversamplingFactor = 1 << oversamplingOrder;
+    currentSampleRate = sampleRate * oversamplingFactor;
+    controlBlockSize = CONTROL_BLOCK_SIZE * oversamplingFactor;
+    preparedBlockSize = samplesPerBlock;
+    oversizedBlockMidi.ensureSize(oversizedBlockMidiBytes);
+    
+    // Render-ahead: the engine renders renderAheadChunkSize-sample chunks instead of host blocks
+    renderAheadChunkSize = getRenderAheadChunkSize(params.renderAhead);
+    const int engineBlockSize = juce::jmax(samplesPerBlock, renderAheadChunkSize);
     
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getTotalNumOutputChannels();
     
-    // Initialize MONO filter
-    monoFilter.prepare(spec);
-    monoFilter.setMode(juce::dsp::LadderFilterMode::LPF24);
-    monoFilter.setEnabled(true);
+    // Initialize MONO filter (24 dB ladder)
+    monoFilter.prepare(currentSampleRate);
     
     // Set filter to match APVTS values and reset to avoid startup transients
-    float cutoff = apvts.getRawParameterValue("cutoff")->load();
-    float resonance = apvts.getRawParameterValue("resonance")->load();
-    monoFilter.setCutoffFrequencyHz(cutoff);
-    monoFilter.setResonance(resonance);
+    float cutoff = params.cutoff;
+    float resonance = params.resonance;
+    monoFilter.setCutoffFrequencyHz(0, cutoff);
+    monoFilter.setResonance(0, resonance);
     monoFilter.reset();
     
     // Initialize MONO filter envelope
-    monoFilterEnv.setSampleRate(sampleRate);
-    juce::ADSR::Parameters monoFilterEnvParams;
-    monoFilterEnvParams.attack = apvts.getRawParameterValue("env1_attack")->load();
-    monoFilterEnvParams.decay = apvts.getRawParameterValue("env1_decay")->load();
-    monoFilterEnvParams.sustain = apvts.getRawParameterValue("env1_sustain")->load();
-    monoFilterEnvParams.release = apvts.getRawParameterValue("env1_release")->load();
-    monoFilterEnv.setParameters(monoFilterEnvParams);
+    monoFilterEnv.setSampleRate(currentSampleRate);
+    monoFilterEnv.setParameters(derived.filterEnv, derived.envExponential);
     
     // Initialize MONO amplitude envelope
-    monoAmpEnv.setSampleRate(sampleRate);
-    juce::ADSR::Parameters monoAmpEnvParams;
-    monoAmpEnvParams.attack = apvts.getRawParameterValue("env2_attack")->load();
-    monoAmpEnvParams.decay = apvts.getRawParameterValue("env2_decay")->load();
-    monoAmpEnvParams.sustain = apvts.getRawParameterValue("env2_sustain")->load();
-    monoAmpEnvParams.release = apvts.getRawParameterValue("env2_release")->load();
-    monoAmpEnv.setParameters(monoAmpEnvParams);
+    monoAmpEnv.setSampleRate(currentSampleRate);
+    monoAmpEnv.setParameters(derived.ampEnv, derived.envExponential);
     
     // Initialize MONO pitch envelope
-    monoPitchEnv.setSampleRate(sampleRate);
-    juce::ADSR::Parameters monoPitchEnvParams;
-    monoPitchEnvParams.attack = apvts.getRawParameterValue("env_pitch_attack")->load();
-    monoPitchEnvParams.decay = apvts.getRawParameterValue("env_pitch_decay")->load();
-    monoPitchEnvParams.sustain = apvts.getRawParameterValue("env_pitch_sustain")->load();
-    monoPitchEnvParams.release = apvts.getRawParameterValue("env_pitch_release")->load();
-    monoPitchEnv.setParameters(monoPitchEnvParams);
-
-    // Initialize paraphonic voices
-    for (int i = 0; i < MAX_VOICES; ++i)
+    monoPitchEnv.setSampleRate(currentSampleRate);
+    monoPitchEnv.setParameters(derived.pitchEnv, derived.envExponential);
+
+    // Allocate the whole voice pool (the only place voice state is allocated; voice_count only
+    // limits how much of it is used, so changing it never allocates on the audio thread)
+    voices.assign((size_t)MAX_VOICES, Neon37Voice{});
+    voiceGroups.resize((size_t)NUM_VOICE_GROUPS);
+    voiceCount = juce::jlimit(1, MAX_VOICES, params.voiceCount);
+    voiceAllocator.reset(voiceCount);
+    
+    // Noise streams restart from their seeds, so every render from here is reproducible
+    noise.seed(noiseSeed);
+    
+    for (int g = 0; g < NUM_VOICE_GROUPS; ++g)
     {
-        // Amp gate: gates the oscillators on/off for click-free operation (paraphonic modes only)
-        // Separate from the shared monoAmpEnv envelope
-        voices[i].ampGate.setSampleRate(sampleRate);
-        juce::ADSR::Parameters gateParams;
-        gateParams.attack = 0.0f;     // Instant on (gate doesn't shape, just switches)
-        gateParams.decay = 0.0f;
-        gateParams.sustain = 1.0f;
-        gateParams.release = 0.0f;    // Instant off (let envelope shape the release)
-        voices[i].ampGate.setParameters(gateParams);
-        
-        // Per-voice filter (poly mode)
-        voices[i].filter.prepare(spec);
-        voices[i].filter.setMode(juce::dsp::LadderFilterMode::LPF24);
-        voices[i].filter.setEnabled(true);
-        voices[i].filter.setCutoffFrequencyHz(cutoff);
-        voices[i].filter.setResonance(resonance);
-        voices[i].filter.reset();
+        auto& group = voiceGroups[(size_t)g];
         
-        // Per-voice filter envelope (poly mode)
-        voices[i].filterEnv.setSampleRate(sampleRate);
-        juce::ADSR::Parameters polyFilterEnvParams;
-        polyFilterEnvParams.attack = apvts.getRawParameterValue("env1_attack")->load();
-        polyFilterEnvParams.decay = apvts.getRawParameterValue("env1_decay")->load();
-        polyFilterEnvParams.sustain = apvts.getRawParameterValue("env1_sustain")->load();
-        polyFilterEnvParams.release = apvts.getRawParameterValue("env1_release")->load();
-        voices[i].filterEnv.setParameters(polyFilterEnvParams);
+        // Paraphonic/poly voice lanes (phases, glide, gates, per-voice envelopes)
+        group.lanes.prepare(currentSampleRate);
+        group.lanes.filterEnv.setParameters(derived.filterEnv, derived.envExponential);
+        group.lanes.ampEnv.setParameters(derived.ampEnv, derived.envExponential);
+        group.lanes.pitchEnv.setParameters(derived.pitchEnv, derived.envExponential);
         
-        // Per-voice amp envelope (poly mode)
-        voices[i].ampEnv.setSampleRate(sampleRate);
-        juce::ADSR::Parameters polyAmpEnvParams;
-        polyAmpEnvParams.attack = apvts.getRawParameterValue("env2_attack")->load();
-        polyAmpEnvParams.decay = apvts.getRawParameterValue("env2_decay")->load();
-        polyAmpEnvParams.sustain = apvts.getRawParameterValue("env2_sustain")->load();
-        polyAmpEnvParams.release = apvts.getRawParameterValue("env2_release")->load();
-        voices[i].ampEnv.setParameters(polyAmpEnvParams);
-        
-        // Per-voice pitch envelope (poly mode)
-        voices[i].pitchEnv.setSampleRate(sampleRate);
-        juce::ADSR::Parameters polyPitchEnvParams;
-        polyPitchEnvParams.attack = apvts.getRawParameterValue("env_pitch_attack")->load();
-        polyPitchEnvParams.decay = apvts.getRawParameterValue("env_pitch_decay")->load();
-        polyPitchEnvParams.sustain = apvts.getRawParameterValue("env_pitch_sustain")->load();
-        polyPitchEnvParams.release = apvts.getRawParameterValue("env_pitch_release")->load();
-        voices[i].pitchEnv.setParameters(polyPitchEnvParams);
-
-        // Voice output buffer
-        voices[i].voiceBuffer.setSize(getTotalNumOutputChannels(), samplesPerBlock);
+        // Per-voice filters (poly mode), one lane each
+        group.filters.prepare(currentSampleRate);
+        for (int lane = 0; lane < VOICE_LANES; ++lane)
+        {
+            group.filters.setCutoffFrequencyHz(lane, cutoff);
+            group.filters.setResonance(lane, resonance);
+        }
+        group.filters.reset();
         
-        // Initialize pitch glide (Hz; will be configured per note-on)
-        voices[i].pitchGlide.reset(sampleRate, 0.001);
-        voices[i].pitchGlide.setCurrentAndTargetValue(juce::MidiMessage::getMidiNoteInHertz(60));
+        // Every voice gets its own stream
+        group.noise.seed(voiceNoiseSeed + (uint32_t)g);
     }
     
-    // Initialize mono pitch glide (Hz)
-    monoPitchGlide.reset(sampleRate, 0.001);
-    monoPitchGlide.setCurrentAndTargetValue(juce::MidiMessage::getMidiNoteInHertz(60));
+    // Size the processBlock scratch arena for the largest block the host will send
+    // Poly rendering threads (the audio thread plus polyThreads - 1 workers); concurrent groups
+    // each need their own voice buffers
+    polyThreads = getPolyThreadCount(params.polyThreads);
+    if (voiceWorkers.getNumWorkers() != polyThreads - 1)
+    {
+        voiceWorkers.stop();
+        if (polyThreads > 1)
+            voiceWorkers.start(polyThreads - 1, juce::Thread::RealtimeOptions{}.withApproximateAudioProcessingTime(samplesPerBlock, sampleRate));
+    }
+    scratch.prepare(engineBlockSize * oversamplingFactor, polyThreads > 1 ? NUM_VOICE_GROUPS : 1);
+
+    // Initialize mono pitch glide (log2 Hz)
+    monoPitchGlide.reset(currentSampleRate, 0.001);
+    monoPitchGlide.setCurrentAndTargetValue(Neon37VoiceLanes::noteToPitch(60));
 
     // Initialize global glide source
-    lastGlideFreqHz = juce::MidiMessage::getMidiNoteInHertz(60);
+    lastGlidePitch = Neon37VoiceLanes::noteToPitch(60);
+    
+    // Render the first block (silence tracking starts over)
+    outputSilent = false;
+    idle = false;
     
     // Initialize output gain to unity
     outputGain.prepare(spec);
     outputGain.setGainLinear(1.0f);
     
-    // Initialize oversampling for alias-free oscillators (4x oversampling)
-    // This upsamples oscillators to prevent aliasing artifacts
-    oversamplingUp = std::make_unique<juce::dsp::Oversampling<float>>(
-        getTotalNumOutputChannels(),  // numChannels
-        2,                             // factor: 4x (2^2 = 4)
-        juce::dsp::Oversampling<float>::FilterType::filterHalfBandPolyphaseIIR,
-        true                           // use double precision
-    );
-    oversamplingUp->initProcessing(samplesPerBlock);
+    // HQ mode decimator (mono: the voice chain is one channel), allocated only when enabled
+    if (oversamplingOrder > 0)
+    {
+        decimator = std::make_unique<Neon37Decimator>();
+        decimator->prepare(oversamplingOrder, engineBlockSize);
+    }
+    else
+    {
+        decimator.reset();
+    }
+    
+    // Render-ahead worker, started last so it only ever sees a fully prepared engine. Its output
+    // runs two chunks behind the host, on top of the decimator's delay.
+    if (renderAheadChunkSize > 0)
+        renderAhead.start(renderAheadChunkSize, samplesPerBlock, renderAheadChunk, this,
+                          juce::Thread::RealtimeOptions{}.withApproximateAudioProcessingTime(renderAheadChunkSize, sampleRate));
+    
+    setLatencySamples((decimator != nullptr ? juce::roundToInt(decimator->getLatencyInSamples()) : 0)
+                      + renderAhead.getLatencySamples());
 }
 
 void Neon37AudioProcessor::releaseResources()
 {
+    preparedBlockSize = 0;
+    renderAhead.stop();
+    voiceWorkers.stop();
+}
+
+void Neon37AudioProcessor::timerCallback()
+{
+    // hq_mode changes the engine rate and buffer sizes, poly_threads and render_ahead start or stop
+    // worker threads (and render_ahead changes the latency): re-prepare outside the audio callback
+    const int requestedOrder = juce::jlimit(0, 3, parameterTable.getInt(Neon37Param::hqMode));
+    const int requestedThreads = getPolyThreadCount(parameterTable.getInt(Neon37Param::polyThreads));
+    const int requestedChunkSize = getRenderAheadChunkSize(parameterTable.getInt(Neon37Param::renderAhead));
+    if (preparedBlockSize > 0 && (requestedOrder != oversamplingOrder || requestedThreads != polyThreads
+                                  || requestedChunkSize != renderAheadChunkSize))
+    {
+        suspendProcessing(true);
+        prepareToPlay(getSampleRate(), preparedBlockSize);
+        suspendProcessing(false);
+    }
 }
 
 bool Neon37AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -236,1134 +281,1282 @@ bool Neon37AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) c
 
 void Neon37AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    NEON37_REALTIME_SCOPE
     juce::ScopedNoDenormals noDenormals;
     
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    // Hosts may exceed the block size announced in prepareToPlay, but the scratch arena, the
+    // decimator and the render-ahead ring are sized for it: split a larger block (and its MIDI,
+    // shifted to each chunk's start) into chunks of at most the prepared size
+    const int numSamples = buffer.getNumSamples();
+    if (preparedBlockSize > 0 && numSamples > preparedBlockSize)
+    {
+        for (int chunkStart = 0; chunkStart < numSamples; chunkStart += preparedBlockSize)
+        {
+            const int chunkSamples = juce::jmin(preparedBlockSize, numSamples - chunkStart);
+            juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), chunkStart, chunkSamples);
+            
+            // Copy only what fits the reservation, so a dense burst never reallocates here
+            oversizedBlockMidi.clear();
+            size_t midiBytes = 0;
+            for (auto it = midiMessages.findNextSamplePosition(chunkStart); it != midiMessages.end(); ++it)
+            {
+                const auto metadata = *it;
+                if (metadata.samplePosition >= chunkStart + chunkSamples)
+                    break;
+                
+                const size_t eventBytes = midiEventHeaderBytes + (size_t)metadata.numBytes;
+                if (midiBytes + eventBytes > oversizedBlockMidiBytes)
+                    continue;
+                
+                midiBytes += eventBytes;
+                oversizedBlockMidi.addEvent(metadata.data, metadata.numBytes, metadata.samplePosition - chunkStart);
+            }
+            
+            renderHostBlock(chunk, oversizedBlockMidi);
+        }
+        return;
+    }
+    
+    renderHostBlock(buffer, midiMessages);
+}
+
+void Neon37AudioProcessor::renderHostBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // Render-ahead: the worker renders the engine; this callback only queues MIDI and drains its output
+    if (renderAhead.isActive())
+    {
+        renderAhead.process(buffer, midiMessages);
+        return;
+    }
     
-    // Process MIDI messages for pitch and envelope control
-    int voiceMode = (int)*apvts.getRawParameterValue("voice_mode");
+    renderEngineBlock(buffer, midiMessages);
+}
+
+void Neon37AudioProcessor::renderAheadChunk(void* context, juce::AudioBuffer<float>& chunk, juce::MidiBuffer& midi)
+{
+    static_cast<Neon37AudioProcessor*>(context)->renderEngineBlock(chunk, midi);
+}
+
+void Neon37AudioProcessor::renderEngineBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numEngineSamples = numSamples * oversamplingFactor;  // Samples at the (HQ) engine rate
+
+    // Refresh this block's parameter snapshot (the only place the audio thread reads the APVTS)
+    // and recompute derived values whose inputs changed. Nothing happens when no knob moved.
+    Neon37ParamSet changedParams;
+    if (parameterTable.update(params, changedParams))
+        derived.update(params, changedParams);
+    
+    int voiceMode = params.voiceMode;
+    
+    // Push envelope parameters to the envelopes they belong to (only if changed)
+    // Done before MIDI so notes triggered this block start with the current settings
+    if (derived.filterEnvChanged)
+    {
+        monoFilterEnv.setParameters(derived.filterEnv, derived.envExponential);
+        for (auto& group : voiceGroups)
+            group.lanes.filterEnv.setParameters(derived.filterEnv, derived.envExponential);
+    }
+
+    if (derived.ampEnvChanged)
+    {
+        monoAmpEnv.setParameters(derived.ampEnv, derived.envExponential);
+        for (auto& group : voiceGroups)
+            group.lanes.ampEnv.setParameters(derived.ampEnv, derived.envExponential);
+    }
+
+    if (derived.pitchEnvChanged)
+    {
+        monoPitchEnv.setParameters(derived.pitchEnv, derived.envExponential);
+        for (auto& group : voiceGroups)
+            group.lanes.pitchEnv.setParameters(derived.pitchEnv, derived.envExponential);
+    }
+
+    derived.clearChangeFlags();
+    
+    if (params.voiceCount != voiceCount)
+        setVoiceCount(params.voiceCount);
+    
+    // Borrow this block's working buffers from the preallocated arena
+    scratch.beginBlock(numEngineSamples);
+    float* monoMix = scratch.getMonoMix();
+    const float* ampEnvBuffer = scratch.getLane(Neon37ScratchArena::ampEnvLane);
+    
+    // === LFO PARAMETERS ===
+    // Update LFO1 parameters
+    float lfo1Rate = params.lfo1Rate;
+    bool lfo1SyncEnabled = params.lfo1Sync;
+    if (lfo1SyncEnabled)
+    {
+        int lfo1SyncVal = params.lfo1SyncVal;
+        lfo1.rate = getSyncMultiplier(lfo1SyncVal) * 2.0f;  // Tempo-synced (2 Hz as base rate)
+    }
+    else
+    {
+        lfo1.rate = lfo1Rate;
+    }
+    lfo1.waveform = params.lfo1Wave;
+    
+    // Update LFO2 parameters
+    float lfo2Rate = params.lfo2Rate;
+    bool lfo2SyncEnabled = params.lfo2Sync;
+    if (lfo2SyncEnabled)
+    {
+        int lfo2SyncVal = params.lfo2SyncVal;
+        lfo2.rate = getSyncMultiplier(lfo2SyncVal) * 2.0f;  // Tempo-synced (2 Hz as base rate)
+    }
+    else
+    {
+        lfo2.rate = lfo2Rate;
+    }
+    lfo2.waveform = params.lfo2Wave;
+    
+    // Check if mod wheel scaling is enabled
+    modWheelEnabled = params.mwEnable;
+    
+    // Idle: nothing is sounding, no MIDI arrives and the last block was already silent (so the
+    // HQ filters hold only silence). Output silence without rendering anything.
+    if (midiMessages.isEmpty() && outputSilent && isSilent(voiceMode))
+    {
+        skipSilentBlock(buffer, numEngineSamples);
+        return;
+    }
     
-    // For paraphonic modes: track which notes were released this block (to deallocate voices)
-    juce::Array<int> releasedNotes;
+    idle = false;
+    const bool silentBefore = isSilent(voiceMode);
     
-    // Process all MIDI messages in a single loop
+    // Sample-accurate MIDI: render up to each event's timestamp, then apply the event.
+    // A block without events is rendered as one segment. The MidiBuffer is iterated in place.
+    int segmentStart = 0;
     for (const auto metadata : midiMessages)
     {
-        const auto msg = metadata.getMessage();
+        const int eventPosition = juce::jlimit(0, numSamples, metadata.samplePosition) * oversamplingFactor;
         
-        // Track mod wheel from CC1
-        if (msg.isController() && msg.getControllerNumber() == 1)  // CC1 = Mod Wheel
+        if (eventPosition > segmentStart)
         {
-            modWheelValue = msg.getControllerValue() / 127.0f;  // Normalize to 0-1
-            modWheelValueRaw = modWheelValue;  // Store raw value for Mod Wheel modulation routing
-            continue;  // Skip to next message
+            renderSegment(segmentStart, eventPosition - segmentStart, voiceMode);
+            segmentStart = eventPosition;
         }
         
-        // Track channel aftertouch (Channel Pressure)
-        if (msg.isChannelPressure())
+        handleMidiEvent(metadata.getMessage(), voiceMode);
+    }
+    
+    if (segmentStart < numEngineSamples)
+        renderSegment(segmentStart, numEngineSamples - segmentStart, voiceMode);
+    
+    // Get master volume (linear, cached)
+    const float masterVol = derived.masterVol;
+    
+    // Apply master volume and amplitude envelope (for MONO/Paraphonic) or just master volume (for Poly)
+    // to the mono mix once, then fan it out to the host's channels
+    if (voiceMode != 4)  // Not poly mode - apply shared amp envelope (already includes all modulations)
+    {
+        for (int sample = 0; sample < numEngineSamples; ++sample)
+            monoMix[sample] *= masterVol * ampEnvBuffer[sample];
+    }
+    else  // Poly mode - just apply master volume (per-voice envelopes already applied)
+    {
+        juce::FloatVectorOperations::multiply(monoMix, masterVol, numEngineSamples);
+    }
+    
+    writeOutput(buffer, monoMix, numSamples);
+    outputSilent = silentBefore && isSilent(voiceMode);
+}
+
+bool Neon37AudioProcessor::isSilent(int voiceMode) const
+{
+    // Nothing can reach the output: the shared amp envelope (Mono/Para) is idle and no Para/Poly voice is active
+    if (voiceMode != 4 && monoAmpEnv.isActive())
+        return false;
+    
+    if (voiceMode >= 2)
+    {
+        for (int g = 0; g < NUM_VOICE_GROUPS; ++g)
         {
-            currentAftertouch = msg.getChannelPressureValue() / 127.0f;  // Normalize to 0-1
+            if (isGroupActive(g))
+                return false;
+        }
+    }
+    
+    return true;
+}
+
+void Neon37AudioProcessor::skipSilentBlock(juce::AudioBuffer<float>& buffer, int numEngineSamples)
+{
+    // HQ filters are cleared once on the way in, so nothing stale comes out when rendering resumes
+    if (!idle && decimator != nullptr)
+        decimator->reset();
+    idle = true;
+    
+    // Free-running state keeps its timing
+    advanceLFOs(numEngineSamples);
+    monoPitchGlide.skip(numEngineSamples);
+    
+    buffer.clear();
+}
+
+void Neon37AudioProcessor::advanceLFOs(int numSamples)
+{
+    lfo1.advance(numSamples, currentSampleRate);
+    lfo2.advance(numSamples, currentSampleRate);
+}
+
+void Neon37AudioProcessor::renderLFOs(int startSample, int numSamples, float modWheelScale, ModulationState& modState)
+{
+    float* pitchOctaves = scratch.getLane(Neon37ScratchArena::lfoPitchLane);
+    float* filterMod = scratch.getLane(Neon37ScratchArena::lfoFilterLane);
+    float* ampMod = scratch.getLane(Neon37ScratchArena::lfoAmpLane);
+    float* wave = scratch.getLane(Neon37ScratchArena::lfoWaveLane) + startSample;
+    
+    juce::FloatVectorOperations::clear(pitchOctaves + startSample, numSamples);
+    juce::FloatVectorOperations::clear(filterMod + startSample, numSamples);
+    juce::FloatVectorOperations::clear(ampMod + startSample, numSamples);
+    
+    // LFO output is bipolar: -1 to +1 representing -100% to +100%, scaled by the mod wheel if enabled.
+    // Each LFO is rendered only if it has routes; pitch routes are in semitones, summed here in octaves.
+    using M = Neon37ModulationMatrix;
+    const std::pair<Neon37LFO*, M::Source> lfos[] = { { &lfo1, M::lfo1 }, { &lfo2, M::lfo2 } };
+    for (const auto& [lfo, source] : lfos)
+    {
+        if (!derived.modMatrix.isRouted(source))
+        {
+            lfo->advance(numSamples, currentSampleRate);
+            continue;
+        }
+        
+        lfo->render(wave, numSamples, currentSampleRate);
+        for (const auto& route : derived.modMatrix)
+        {
+            if (route.source != source)
+                continue;
             
-            // In poly mode, apply channel aftertouch to all active voices
-            if (voiceMode == 4)
+            switch (route.destination)
             {
-                for (int i = 0; i < MAX_VOICES; ++i)
-                {
-                    if (voices[i].active)
-                    {
-                        voices[i].aftertouch = currentAftertouch;
-                    }
-                }
+                case M::pitch:  juce::FloatVectorOperations::addWithMultiply(pitchOctaves + startSample, wave, route.amount * modWheelScale / 12.0f, numSamples); break;
+                case M::cutoff: juce::FloatVectorOperations::addWithMultiply(filterMod + startSample, wave, route.amount * modWheelScale, numSamples); break;
+                case M::amp:    juce::FloatVectorOperations::addWithMultiply(ampMod + startSample, wave, route.amount * modWheelScale, numSamples); break;
+                default:        jassertfalse; break;  // No per-sample LFO path for this destination yet
             }
-            continue;
         }
+    }
+    
+    modState.lfoPitchOctaves = pitchOctaves;
+    modState.lfoFilterMod = filterMod;
+    modState.lfoAmpMod = ampMod;
+}
+
+void Neon37AudioProcessor::writeOutput(juce::AudioBuffer<float>& buffer, const float* monoMix, int numSamples)
+{
+    if (buffer.getNumChannels() == 0)
+        return;
+    
+    if (decimator != nullptr)
+    {
+        // HQ mode: the mix is at the engine rate; decimate it into channel 0 at the host rate
+        decimator->process(monoMix, buffer.getWritePointer(0), numSamples);
+    }
+    else
+    {
+        buffer.copyFrom(0, 0, monoMix, numSamples);
+    }
+    
+    // The whole voice chain is mono; this is the only stage that sees the host's channel layout
+    for (int channel = 1; channel < buffer.getNumChannels(); ++channel)
+        buffer.copyFrom(channel, 0, buffer, 0, 0, numSamples);
+}
+
+void Neon37AudioProcessor::handleMidiEvent(const juce::MidiMessage& msg, int voiceMode)
+{
+    // Track mod wheel from CC1
+    if (msg.isController() && msg.getControllerNumber() == 1)  // CC1 = Mod Wheel
+    {
+        modWheelValue = msg.getControllerValue() / 127.0f;  // Normalize to 0-1
+        modWheelValueRaw = modWheelValue;  // Store raw value for Mod Wheel modulation routing
+        return;  // Nothing else to do for this message
+    }
+    
+    // Track channel aftertouch (Channel Pressure)
+    if (msg.isChannelPressure())
+    {
+        currentAftertouch = msg.getChannelPressureValue() / 127.0f;  // Normalize to 0-1
         
-        // Also track polyphonic aftertouch (per-note pressure)
-        if (msg.isAftertouch())
+        // In poly mode, apply channel aftertouch to all active voices
+        if (voiceMode == 4)
         {
-            int aftertouchNote = msg.getNoteNumber();
-            float aftertouchValue = msg.getAfterTouchValue() / 127.0f;
-            currentAftertouch = aftertouchValue;  // Also update global for MONO/Paraphonic modes
-            
-            // In poly mode, apply aftertouch only to the specific note
-            if (voiceMode == 4)
+            for (int i = 0; i < MAX_VOICES; ++i)
             {
-                for (int i = 0; i < MAX_VOICES; ++i)
+                if (voices[i].active)
                 {
-                    if (voices[i].active && voices[i].midiNote == aftertouchNote)
-                    {
-                        voices[i].aftertouch = aftertouchValue;
-                        break;
-                    }
+                    voices[i].aftertouch = currentAftertouch;
                 }
             }
-            continue;
         }
+        return;
+    }
+    
+    // Also track polyphonic aftertouch (per-note pressure)
+    if (msg.isAftertouch())
+    {
+        int aftertouchNote = msg.getNoteNumber();
+        float aftertouchValue = msg.getAfterTouchValue() / 127.0f;
+        currentAftertouch = aftertouchValue;  // Also update global for MONO/Paraphonic modes
         
-        // Track pitch bend
-        if (msg.isPitchWheel())
+        // In poly mode, apply aftertouch only to the specific note
+        if (voiceMode == 4)
         {
-            pitchBendValue = (msg.getPitchWheelValue() - 8192.0f) / 8192.0f;  // Normalize to -1 to +1
-            continue;
+            const int v = voiceAllocator.voiceForNote(aftertouchNote);
+            if (v >= 0)
+                voices[(size_t)v].aftertouch = aftertouchValue;
         }
-        if (msg.isNoteOn())
-        {
-            int midiNote = msg.getNoteNumber();
-            const bool wasAnyKeyDown = (keysDownCount > 0);
+        return;
+    }
+    
+    // Track pitch bend
+    if (msg.isPitchWheel())
+    {
+        pitchBendValue = (msg.getPitchWheelValue() - 8192.0f) / 8192.0f;  // Normalize to -1 to +1
+        return;
+    }
+    if (msg.isNoteOn())
+    {
+        int midiNote = msg.getNoteNumber();
+        const bool wasAnyKeyDown = (keysDownCount > 0);
 
-            // Track physically held keys (note-on)
-            if (midiNote >= 0 && midiNote < 128)
+        // Track physically held keys (note-on)
+        if (midiNote >= 0 && midiNote < 128)
+        {
+            if (!keysDown[(size_t)midiNote])
             {
-                if (!keysDown[(size_t)midiNote])
-                {
-                    keysDown[(size_t)midiNote] = true;
-                    ++keysDownCount;
-                }
+                keysDown[(size_t)midiNote] = true;
+                ++keysDownCount;
             }
+        }
 
-            // Track velocity (0-127 normalized to 0-1)
-            currentVelocity = msg.getVelocity() / 127.0f;
-            
-            // Handle LFO key reset
-            bool lfo1KeyReset = apvts.getRawParameterValue("lfo1_key_reset")->load() > 0.5f;
-            bool lfo2KeyReset = apvts.getRawParameterValue("lfo2_key_reset")->load() > 0.5f;
-            
-            if (lfo1KeyReset) lfo1.phase = 0.0f;
-            if (lfo2KeyReset) lfo2.phase = 0.0f;
+        // Track velocity (0-127 normalized to 0-1)
+        currentVelocity = msg.getVelocity() / 127.0f;
+        
+        // Handle LFO key reset
+        bool lfo1KeyReset = params.lfo1KeyReset;
+        bool lfo2KeyReset = params.lfo2KeyReset;
+        
+        if (lfo1KeyReset) lfo1.phase = 0.0;
+        if (lfo2KeyReset) lfo2.phase = 0.0;
+        
+        if (voiceMode == 0 || voiceMode == 1)  // MONO or MONO-L
+        {
+            // Mono legato = at least one other note already held
+            const bool wasLegato = !noteStack.empty();
             
-            if (voiceMode == 0 || voiceMode == 1)  // MONO or MONO-L
-            {
-                // Mono legato = at least one other note already held
-                const bool wasLegato = !noteStack.empty();
-                
-                // Get glide parameters
-                float glideTimeMs = apvts.getRawParameterValue("glide_time")->load();
-                bool glideRate = apvts.getRawParameterValue("glide_rate")->load() > 0.5f;
-                bool glideLegato = apvts.getRawParameterValue("glide_legato")->load() > 0.5f;
-                
-                // Apply glide if enabled and conditions are met
-                const bool shouldGlide = glideTimeMs > 0.0f && (!glideLegato || wasLegato);
+            // Apply glide if enabled and conditions are met
+            const bool shouldGlide = params.glideTimeMs > 0.0f && (!params.glideLegato || wasLegato);
 
-                // Maintain a unique, most-recent-first note stack
-                if (auto it = std::find(noteStack.begin(), noteStack.end(), midiNote); it != noteStack.end())
-                    noteStack.erase(it);
-                noteStack.push_back(midiNote);
+            // Maintain a unique, most-recent-first note stack
+            if (auto it = std::find(noteStack.begin(), noteStack.end(), midiNote); it != noteStack.end())
+                noteStack.erase(it);
+            noteStack.push_back(midiNote);
 
-                currentMidiNote = midiNote;
-                
-                const float targetFreqHz = juce::MidiMessage::getMidiNoteInHertz(midiNote);
+            currentMidiNote = midiNote;
+            
+            const float targetPitch = Neon37VoiceLanes::noteToPitch(midiNote);
 
-                // Configure portamento (smooth frequency in Hz)
-                if (shouldGlide)
-                {
-                    const float currentFreqHz = monoPitchGlide.getCurrentValue();
-
-                    if (glideRate)
-                    {
-                        // Rate mode: constant semitones/sec implemented via time proportional to interval.
-                        // Interpret glideTimeMs as "time for 1 octave".
-                        const float ratio = targetFreqHz / juce::jmax(1.0e-6f, currentFreqHz);
-                        const float octaves = std::abs(std::log2(juce::jmax(1.0e-6f, ratio)));
-                        float timeSeconds = (glideTimeMs / 1000.0f) * octaves;
-                        timeSeconds = juce::jlimit(0.001f, 5.0f, timeSeconds);
-                        monoPitchGlide.reset(currentSampleRate, timeSeconds);
-                    }
-                    else
-                    {
-                        // Time mode: constant time regardless of interval
-                        monoPitchGlide.reset(currentSampleRate, glideTimeMs / 1000.0f);
-                    }
-                    monoPitchGlide.setTargetValue(targetFreqHz);
-                }
-                else
-                {
-                    // No glide: instant jump
-                    monoPitchGlide.setCurrentAndTargetValue(targetFreqHz);
-                }
+            // Configure portamento (linear in log2 Hz)
+            if (shouldGlide)
+            {
+                monoPitchGlide.reset(currentSampleRate, getGlideSeconds(monoPitchGlide.getCurrentValue(), targetPitch));
+                monoPitchGlide.setTargetValue(targetPitch);
+            }
+            else
+            {
+                // No glide: instant jump
+                monoPitchGlide.setCurrentAndTargetValue(targetPitch);
+            }
 
-                lastGlideFreqHz = targetFreqHz;
-                
-                // Envelope retrigger logic:
-                // Mono (mode 1): Always retrigger
-                // Mono-L (mode 0): Only retrigger if no note was previously held (staccato)
-                bool shouldRetrigger = false;
-                if (voiceMode == 1) // Mono
-                {
-                    shouldRetrigger = true;
-                }
-                else if (voiceMode == 0 && !wasLegato) // Mono-L, first note pressed
-                {
-                    shouldRetrigger = true;
-                }
+            lastGlidePitch = targetPitch;
+            
+            // Envelope retrigger logic:
+            // Mono (mode 1): Always retrigger
+            // Mono-L (mode 0): Only retrigger if no note was previously held (staccato)
+            bool shouldRetrigger = false;
+            if (voiceMode == 1) // Mono
+            {
+                shouldRetrigger = true;
+            }
+            else if (voiceMode == 0 && !wasLegato) // Mono-L, first note pressed
+            {
+                shouldRetrigger = true;
+            }
+            
+            if (shouldRetrigger)
+            {
+                monoFilterEnv.noteOn();
+                monoAmpEnv.noteOn();
+                monoPitchEnv.noteOn();
+                monoUnison.spreadPhases(derived.unisonCount, params.unisonSpread);
                 
-                if (shouldRetrigger)
+                // Pre-set filter to initial envelope value to eliminate attack lag
+                // When envelope attack is fast, snap filter to starting position
+                float env1Attack = params.env1Attack;
+                if (env1Attack < 0.005f)  // If attack < 5ms, snap immediately
                 {
-                    monoFilterEnv.noteOn();
-                    monoAmpEnv.noteOn();
-                    monoPitchEnv.noteOn();
-                    monoFilter.reset();  // Reset filter smoothing state for instant response
+                    float initialEnvValue = 0.0f;  // Envelope starts at 0
+                    float egDepth = params.egDepth;
+                    float baseCutoff = params.cutoff;
+                    float resonance = params.resonance;
+                    
+                    // Calculate modulations (velocity and aftertouch routes)
+                    Neon37ModulationMatrix::DestinationValues noteMod{};
+                    derived.modMatrix.accumulate(getControlSourceValues(), Neon37ModulationMatrix::noteSources, noteMod);
+                    float totalFilterModMultiplier = 1.0f + juce::jlimit(-5.0f, 5.0f, noteMod[Neon37ModulationMatrix::cutoff]);
                     
-                    // Pre-set filter to initial envelope value to eliminate attack lag
-                    // When envelope attack is fast, snap filter to starting position
-                    float env1Attack = apvts.getRawParameterValue("env1_attack")->load();
-                    if (env1Attack < 0.005f)  // If attack < 5ms, snap immediately
-                    {
-                        float initialEnvValue = 0.0f;  // Envelope starts at 0
-                        float egDepth = apvts.getRawParameterValue("eg_depth")->load();
-                        float baseCutoff = apvts.getRawParameterValue("cutoff")->load();
-                        float resonance = apvts.getRawParameterValue("resonance")->load();
-                        
-                        // Calculate modulations
-                        float velFilterAmount = *apvts.getRawParameterValue("vel_filter");
-                        float atFilterAmount = *apvts.getRawParameterValue("at_filter");
-                        float velFilterMod = velFilterAmount * currentVelocity;
-                        float atFilterMod = atFilterAmount * currentAftertouch;
-                        float totalFilterMod = velFilterMod + atFilterMod;
-                        float totalFilterModMultiplier = 1.0f + juce::jlimit(-5.0f, 5.0f, totalFilterMod);
-                        
-                        float initialCutoff = calculateModulatedCutoff(baseCutoff, initialEnvValue, egDepth, totalFilterModMultiplier, resonance);
-                        monoFilter.setCutoffFrequencyHz(initialCutoff);
-                        monoFilter.setResonance(resonance);
-                    }
+                    float initialCutoff = calculateModulatedCutoff(baseCutoff, initialEnvValue, egDepth, totalFilterModMultiplier, resonance);
+                    monoFilter.setCutoffFrequencyHz(0, initialCutoff);
+                    monoFilter.setResonance(0, resonance);
                 }
+                
+                // Reset filter state after any pre-set so the cutoff jumps to it instead of ramping
+                monoFilter.reset();
             }
-            else if (voiceMode == 2 || voiceMode == 3)  // Paraphonic modes (Para-L, Para)
-            {
-                const bool isLegato = wasAnyKeyDown;
+        }
+        else if (voiceMode == 2 || voiceMode == 3)  // Paraphonic modes (Para-L, Para)
+        {
+            const bool isLegato = wasAnyKeyDown;
 
-                float glideTimeMs = apvts.getRawParameterValue("glide_time")->load();
-                bool glideRate = apvts.getRawParameterValue("glide_rate")->load() > 0.5f;
-                bool glideLegato = apvts.getRawParameterValue("glide_legato")->load() > 0.5f;
-                const bool shouldGlide = glideTimeMs > 0.0f && (!glideLegato || isLegato);
+            const bool shouldGlide = params.glideTimeMs > 0.0f && (!params.glideLegato || isLegato);
 
-                // Allocate voice (refactored into helper)
-                int voiceToAllocate = allocateVoice();
-                
-                // Allocate voice
-                voices[voiceToAllocate].midiNote = midiNote;
-                voices[voiceToAllocate].active = true;
-                voices[voiceToAllocate].allocationTimestamp = ++voiceAllocationCounter;
-                voices[voiceToAllocate].ampGate.noteOn();
+            // A retriggered note closes its old gate first, so the note keeps a single voice
+            const int previousVoice = voiceAllocator.voiceForNote(midiNote);
+            if (previousVoice >= 0)
+            {
+                groupOf(previousVoice).lanes.gate[(size_t)laneOf(previousVoice)] = 0.0f;
+                freeVoice(previousVoice);
+            }
 
-                const float targetFreqHz = juce::MidiMessage::getMidiNoteInHertz(midiNote);
-                const float sourceFreqHz = shouldGlide ? lastGlideFreqHz : targetFreqHz;
+            int voiceToAllocate = allocateVoice(midiNote, voiceMode);
+            groupOf(voiceToAllocate).lanes.gate[(size_t)laneOf(voiceToAllocate)] = 1.0f;
 
-                voices[voiceToAllocate].pitchGlide.setCurrentAndTargetValue(sourceFreqHz);
-                if (shouldGlide)
-                {
-                    if (glideRate)
-                    {
-                        const float ratio = targetFreqHz / juce::jmax(1.0e-6f, sourceFreqHz);
-                        const float octaves = std::abs(std::log2(juce::jmax(1.0e-6f, ratio)));
-                        float timeSeconds = (glideTimeMs / 1000.0f) * octaves;
-                        timeSeconds = juce::jlimit(0.001f, 5.0f, timeSeconds);
-                        voices[voiceToAllocate].pitchGlide.reset(currentSampleRate, timeSeconds);
-                    }
-                    else
-                    {
-                        voices[voiceToAllocate].pitchGlide.reset(currentSampleRate, glideTimeMs / 1000.0f);
-                    }
-                    voices[voiceToAllocate].pitchGlide.setTargetValue(targetFreqHz);
-                }
-                else
-                {
-                    voices[voiceToAllocate].pitchGlide.setCurrentAndTargetValue(targetFreqHz);
-                }
+            const float targetPitch = Neon37VoiceLanes::noteToPitch(midiNote);
+            const float sourcePitch = shouldGlide ? lastGlidePitch : targetPitch;
+            const float glideSeconds = shouldGlide ? getGlideSeconds(sourcePitch, targetPitch) : 0.0f;
+            groupOf(voiceToAllocate).lanes.setGlide(laneOf(voiceToAllocate), sourcePitch, targetPitch, glideSeconds * (float)currentSampleRate);
 
-                lastGlideFreqHz = targetFreqHz;
-                
-                // Envelope retrigger logic for paraphonic modes:
-                // Para-L (mode 2): Only retrigger if this is the first note after all notes were released
-                // Para (mode 3): Always retrigger on every new note-on
-                bool shouldRetriggerEnvelopes = false;
-                if (voiceMode == 2)  // Para-L
-                {
-                    // Only retrigger if no voices were active last block (transition from silence to notes)
-                    shouldRetriggerEnvelopes = !lastBlockHadAnyActiveVoices;
-                }
-                else  // Para (mode 3) - always retrigger
-                {
-                    shouldRetriggerEnvelopes = true;
-                }
+            lastGlidePitch = targetPitch;
+            
+            // Envelope retrigger logic for paraphonic modes:
+            // Para-L (mode 2): Only retrigger if this is the first note after all notes were released
+            // Para (mode 3): Always retrigger on every new note-on
+            bool shouldRetriggerEnvelopes = false;
+            if (voiceMode == 2)  // Para-L
+            {
+                // Only retrigger if no voices were active up to this event (transition from silence to notes)
+                shouldRetriggerEnvelopes = !lastSegmentHadAnyActiveVoices;
+            }
+            else  // Para (mode 3) - always retrigger
+            {
+                shouldRetriggerEnvelopes = true;
+            }
+            
+            if (shouldRetriggerEnvelopes)
+            {
+                monoFilterEnv.noteOn();
+                monoAmpEnv.noteOn();
+                monoPitchEnv.noteOn();
                 
-                if (shouldRetriggerEnvelopes)
+                // Pre-set filter to initial envelope value to eliminate attack lag
+                float env1Attack = params.env1Attack;
+                if (env1Attack < 0.005f)  // If attack < 5ms, snap immediately
                 {
-                    monoFilterEnv.noteOn();
-                    monoAmpEnv.noteOn();
-                    monoPitchEnv.noteOn();
-                    monoFilter.reset();  // Reset filter smoothing state for instant response
+                    float initialEnvValue = 0.0f;
+                    float egDepth = params.egDepth;
+                    float baseCutoff = params.cutoff;
+                    float resonance = params.resonance;
+                    
+                    // Calculate modulations (velocity and aftertouch routes)
+                    Neon37ModulationMatrix::DestinationValues noteMod{};
+                    derived.modMatrix.accumulate(getControlSourceValues(), Neon37ModulationMatrix::noteSources, noteMod);
+                    float totalFilterModMultiplier = 1.0f + juce::jlimit(-5.0f, 5.0f, noteMod[Neon37ModulationMatrix::cutoff]);
                     
-                    // Pre-set filter to initial envelope value to eliminate attack lag
-                    float env1Attack = apvts.getRawParameterValue("env1_attack")->load();
-                    if (env1Attack < 0.005f)  // If attack < 5ms, snap immediately
-                    {
-                        float initialEnvValue = 0.0f;
-                        float egDepth = apvts.getRawParameterValue("eg_depth")->load();
-                        float baseCutoff = apvts.getRawParameterValue("cutoff")->load();
-                        float resonance = apvts.getRawParameterValue("resonance")->load();
-                        
-                        float velFilterAmount = *apvts.getRawParameterValue("vel_filter");
-                        float atFilterAmount = *apvts.getRawParameterValue("at_filter");
-                        float velFilterMod = velFilterAmount * currentVelocity;
-                        float atFilterMod = atFilterAmount * currentAftertouch;
-                        float totalFilterMod = velFilterMod + atFilterMod;
-                        float totalFilterModMultiplier = 1.0f + juce::jlimit(-5.0f, 5.0f, totalFilterMod);
-                        
-                        float initialCutoff = calculateModulatedCutoff(baseCutoff, initialEnvValue, egDepth, totalFilterModMultiplier, resonance);
-                        monoFilter.setCutoffFrequencyHz(initialCutoff);
-                        monoFilter.setResonance(resonance);
-                    }
+                    float initialCutoff = calculateModulatedCutoff(baseCutoff, initialEnvValue, egDepth, totalFilterModMultiplier, resonance);
+                    monoFilter.setCutoffFrequencyHz(0, initialCutoff);
+                    monoFilter.setResonance(0, resonance);
                 }
+                
+                // Reset filter state after any pre-set so the cutoff jumps to it instead of ramping
+                monoFilter.reset();
             }
-            else if (voiceMode == 4)  // Poly mode
+        }
+        else if (voiceMode == 4)  // Poly mode
+        {
+            // If this note is already playing, stop the old voice immediately
+            const int previousVoice = voiceAllocator.voiceForNote(midiNote);
+            if (previousVoice >= 0)
             {
-                // If this note is already playing, stop the old voice immediately
-                for (int i = 0; i < MAX_VOICES; ++i)
-                {
-                    if (voices[i].active && voices[i].midiNote == midiNote)
-                    {
-                        // Force the old voice to stop immediately (don't just noteOff, fully deactivate)
-                        voices[i].active = false;
-                        voices[i].ampEnv.noteOff();
-                        voices[i].filterEnv.noteOff();
-                        voices[i].pitchEnv.noteOff();
-                        break;
-                    }
-                }
-                
-                const bool isLegato = wasAnyKeyDown;
+                // Force the old voice to stop immediately (don't just noteOff, fully deactivate)
+                freeVoice(previousVoice);
+                auto& lanes = groupOf(previousVoice).lanes;
+                lanes.ampEnv.noteOff(laneOf(previousVoice));
+                lanes.filterEnv.noteOff(laneOf(previousVoice));
+                lanes.pitchEnv.noteOff(laneOf(previousVoice));
+            }
+            
+            const bool isLegato = wasAnyKeyDown;
 
-                float glideTimeMs = apvts.getRawParameterValue("glide_time")->load();
-                bool glideRate = apvts.getRawParameterValue("glide_rate")->load() > 0.5f;
-                bool glideLegato = apvts.getRawParameterValue("glide_legato")->load() > 0.5f;
-                const bool shouldGlide = glideTimeMs > 0.0f && (!glideLegato || isLegato);
+            const bool shouldGlide = params.glideTimeMs > 0.0f && (!params.glideLegato || isLegato);
 
-                // Allocate voice for the new trigger
-                int voiceToAllocate = allocateVoice();
-                
-                // Allocate voice
-                voices[voiceToAllocate].midiNote = midiNote;
-                voices[voiceToAllocate].active = true;
-                voices[voiceToAllocate].allocationTimestamp = ++voiceAllocationCounter;
-                voices[voiceToAllocate].velocity = currentVelocity;  // Store this note's velocity
-                voices[voiceToAllocate].aftertouch = 0.0f;  // Initialize aftertouch to 0
+            // Allocate voice for the new trigger
+            int voiceToAllocate = allocateVoice(midiNote, voiceMode);
+            voices[voiceToAllocate].velocity = currentVelocity;  // Store this note's velocity
+            voices[voiceToAllocate].aftertouch = 0.0f;  // Initialize aftertouch to 0
 
-                const float targetFreqHz = juce::MidiMessage::getMidiNoteInHertz(midiNote);
-                const float sourceFreqHz = shouldGlide ? lastGlideFreqHz : targetFreqHz;
+            const float targetPitch = Neon37VoiceLanes::noteToPitch(midiNote);
+            const float sourcePitch = shouldGlide ? lastGlidePitch : targetPitch;
+            const float glideSeconds = shouldGlide ? getGlideSeconds(sourcePitch, targetPitch) : 0.0f;
+            groupOf(voiceToAllocate).lanes.setGlide(laneOf(voiceToAllocate), sourcePitch, targetPitch, glideSeconds * (float)currentSampleRate);
 
-                voices[voiceToAllocate].pitchGlide.setCurrentAndTargetValue(sourceFreqHz);
-                if (shouldGlide)
-                {
-                    if (glideRate)
-                    {
-                        const float ratio = targetFreqHz / juce::jmax(1.0e-6f, sourceFreqHz);
-                        const float octaves = std::abs(std::log2(juce::jmax(1.0e-6f, ratio)));
-                        float timeSeconds = (glideTimeMs / 1000.0f) * octaves;
-                        timeSeconds = juce::jlimit(0.001f, 5.0f, timeSeconds);
-                        voices[voiceToAllocate].pitchGlide.reset(currentSampleRate, timeSeconds);
-                    }
-                    else
-                    {
-                        voices[voiceToAllocate].pitchGlide.reset(currentSampleRate, glideTimeMs / 1000.0f);
-                    }
-                    voices[voiceToAllocate].pitchGlide.setTargetValue(targetFreqHz);
-                }
-                else
-                {
-                    voices[voiceToAllocate].pitchGlide.setCurrentAndTargetValue(targetFreqHz);
-                }
+            lastGlidePitch = targetPitch;
+            
+            // Trigger per-voice envelopes (always retrigger in poly mode, like MONO)
+            auto& group = groupOf(voiceToAllocate);
+            const int lane = laneOf(voiceToAllocate);
+            group.lanes.filterEnv.noteOn(lane);
+            group.lanes.ampEnv.noteOn(lane);
+            group.lanes.pitchEnv.noteOn(lane);
+            group.filters.reset(lane);  // Clear filter state to avoid startup transients
+        }
+    }
+    else if (msg.isNoteOff())
+    {
+        int midiNote = msg.getNoteNumber();
 
-                lastGlideFreqHz = targetFreqHz;
-                
-                // Trigger per-voice envelopes (always retrigger in poly mode, like MONO)
-                voices[voiceToAllocate].filterEnv.noteOn();
-                voices[voiceToAllocate].ampEnv.noteOn();
-                voices[voiceToAllocate].pitchEnv.noteOn();
-                voices[voiceToAllocate].filter.reset();  // Clear filter state to avoid startup transients
+        // Track physically held keys (note-off)
+        if (midiNote >= 0 && midiNote < 128)
+        {
+            if (keysDown[(size_t)midiNote])
+            {
+                keysDown[(size_t)midiNote] = false;
+                keysDownCount = juce::jmax(0, keysDownCount - 1);
             }
         }
-        else if (msg.isNoteOff())
+        
+        if (voiceMode == 0 || voiceMode == 1)  // MONO or MONO-L
         {
-            int midiNote = msg.getNoteNumber();
+            // Remove from note stack (unique list; remove any occurrences defensively)
+            noteStack.erase(std::remove(noteStack.begin(), noteStack.end(), midiNote), noteStack.end());
 
-            // Track physically held keys (note-off)
-            if (midiNote >= 0 && midiNote < 128)
-            {
-                if (keysDown[(size_t)midiNote])
-                {
-                    keysDown[(size_t)midiNote] = false;
-                    keysDownCount = juce::jmax(0, keysDownCount - 1);
-                }
-            }
-            
-            if (voiceMode == 0 || voiceMode == 1)  // MONO or MONO-L
+            // If there are still held notes, switch to the most recent one
+            if (!noteStack.empty())
             {
-                // Remove from note stack (unique list; remove any occurrences defensively)
-                noteStack.erase(std::remove(noteStack.begin(), noteStack.end(), midiNote), noteStack.end());
+                const int nextNote = noteStack.back();
+                currentMidiNote = nextNote;
+
+                const float targetPitch = Neon37VoiceLanes::noteToPitch(nextNote);
+
+                // Configure glide for the note switch (release-to-held-note counts as legato)
+                const bool shouldGlide = params.glideTimeMs > 0.0f;
 
-                // If there are still held notes, switch to the most recent one
-                if (!noteStack.empty())
+                if (shouldGlide)
                 {
-                    const int nextNote = noteStack.back();
-                    currentMidiNote = nextNote;
-
-                    const float targetFreqHz = juce::MidiMessage::getMidiNoteInHertz(nextNote);
-
-                    // Configure glide for the note switch (release-to-held-note counts as legato)
-                    float glideTimeMs = apvts.getRawParameterValue("glide_time")->load();
-                    bool glideRate = apvts.getRawParameterValue("glide_rate")->load() > 0.5f;
-                    bool glideLegato = apvts.getRawParameterValue("glide_legato")->load() > 0.5f;
-                    const bool isLegato = true;
-                    const bool shouldGlide = glideTimeMs > 0.0f && (!glideLegato || isLegato);
-
-                    if (shouldGlide)
-                    {
-                        const float currentFreqHz = monoPitchGlide.getCurrentValue();
-                        if (glideRate)
-                        {
-                            const float ratio = targetFreqHz / juce::jmax(1.0e-6f, currentFreqHz);
-                            const float octaves = std::abs(std::log2(juce::jmax(1.0e-6f, ratio)));
-                            float timeSeconds = (glideTimeMs / 1000.0f) * octaves;
-                            timeSeconds = juce::jlimit(0.001f, 5.0f, timeSeconds);
-                            monoPitchGlide.reset(currentSampleRate, timeSeconds);
-                        }
-                        else
-                        {
-                            monoPitchGlide.reset(currentSampleRate, glideTimeMs / 1000.0f);
-                        }
-                        monoPitchGlide.setTargetValue(targetFreqHz);
-                    }
-                    else
-                    {
-                        monoPitchGlide.setCurrentAndTargetValue(targetFreqHz);
-                    }
-
-                    lastGlideFreqHz = targetFreqHz;
-
-                    // For Mono mode, retrigger the envelope on note switch
-                    if (voiceMode == 1)
-                    {
-                        monoFilterEnv.noteOn();
-                        monoAmpEnv.noteOn();
-                        monoPitchEnv.noteOn();
-                    }
+                    monoPitchGlide.reset(currentSampleRate, getGlideSeconds(monoPitchGlide.getCurrentValue(), targetPitch));
+                    monoPitchGlide.setTargetValue(targetPitch);
                 }
                 else
                 {
-                    // All keys released
-                    monoFilterEnv.noteOff();
-                    monoAmpEnv.noteOff();
-                    monoPitchEnv.noteOff();
+                    monoPitchGlide.setCurrentAndTargetValue(targetPitch);
                 }
-            }
-            else if (voiceMode == 2 || voiceMode == 3)  // Paraphonic modes
-            {
-                releasedNotes.add(midiNote);
-            }
-            else if (voiceMode == 4)  // Poly mode
-            {
-                // Find voice matching this note and trigger both filter and amp envelope release
-                for (int i = 0; i < MAX_VOICES; ++i)
+
+                lastGlidePitch = targetPitch;
+
+                // For Mono mode, retrigger the envelope on note switch
+                if (voiceMode == 1)
                 {
-                    if (voices[i].active && voices[i].midiNote == midiNote)
-                    {
-                        voices[i].filterEnv.noteOff();
-                        voices[i].ampEnv.noteOff();
-                        voices[i].pitchEnv.noteOff();
-                        break;
-                    }
+                    monoFilterEnv.noteOn();
+                    monoAmpEnv.noteOn();
+                    monoPitchEnv.noteOn();
                 }
             }
+            else
+            {
+                // All keys released
+                monoFilterEnv.noteOff();
+                monoAmpEnv.noteOff();
+                monoPitchEnv.noteOff();
+            }
         }
-    }
-    
-    // Update filter envelope parameters in real-time (only if changed)
-    float env1Attack = apvts.getRawParameterValue("env1_attack")->load();
-    float env1Decay = apvts.getRawParameterValue("env1_decay")->load();
-    float env1Sustain = apvts.getRawParameterValue("env1_sustain")->load();
-    float env1Release = apvts.getRawParameterValue("env1_release")->load();
-    
-    if (env1Attack != cachedEnv1Attack || env1Decay != cachedEnv1Decay || 
-        env1Sustain != cachedEnv1Sustain || env1Release != cachedEnv1Release)
-    {
-        cachedEnv1Attack = env1Attack;
-        cachedEnv1Decay = env1Decay;
-        cachedEnv1Sustain = env1Sustain;
-        cachedEnv1Release = env1Release;
-        
-        juce::ADSR::Parameters filterEnvParams;
-        filterEnvParams.attack = env1Attack;
-        filterEnvParams.decay = env1Decay;
-        filterEnvParams.sustain = env1Sustain;
-        filterEnvParams.release = env1Release;
-        monoFilterEnv.setParameters(filterEnvParams);
-        
-        // Update poly mode per-voice filter envelopes too
-        for (int i = 0; i < MAX_VOICES; ++i)
+        else if (voiceMode == 2 || voiceMode == 3)  // Paraphonic modes
         {
-            voices[i].filterEnv.setParameters(filterEnvParams);
+            // Release this note's gate now; the shared envelopes release once the last gate has closed
+            const int v = voiceAllocator.voiceForNote(midiNote);
+            if (v >= 0)
+            {
+                groupOf(v).lanes.gate[(size_t)laneOf(v)] = 0.0f;
+                voiceAllocator.noteReleased(v);
+            }
         }
-    }
-    
-    // Update amplitude envelope parameters in real-time (only if changed)
-    float env2Attack = apvts.getRawParameterValue("env2_attack")->load();
-    float env2Decay = apvts.getRawParameterValue("env2_decay")->load();
-    float env2Sustain = apvts.getRawParameterValue("env2_sustain")->load();
-    float env2Release = apvts.getRawParameterValue("env2_release")->load();
-    
-    if (env2Attack != cachedEnv2Attack || env2Decay != cachedEnv2Decay || 
-        env2Sustain != cachedEnv2Sustain || env2Release != cachedEnv2Release)
-    {
-        cachedEnv2Attack = env2Attack;
-        cachedEnv2Decay = env2Decay;
-        cachedEnv2Sustain = env2Sustain;
-        cachedEnv2Release = env2Release;
-        
-        juce::ADSR::Parameters ampEnvParams;
-        ampEnvParams.attack = env2Attack;
-        ampEnvParams.decay = env2Decay;
-        ampEnvParams.sustain = env2Sustain;
-        ampEnvParams.release = env2Release;
-        monoAmpEnv.setParameters(ampEnvParams);
-        
-        // Update poly mode per-voice amp envelopes too
-        for (int i = 0; i < MAX_VOICES; ++i)
+        else if (voiceMode == 4)  // Poly mode
         {
-            voices[i].ampEnv.setParameters(ampEnvParams);
+            // Release the voice playing this note; it keeps sounding until its amp envelope ends
+            const int v = voiceAllocator.voiceForNote(midiNote);
+            if (v >= 0)
+            {
+                auto& lanes = groupOf(v).lanes;
+                lanes.filterEnv.noteOff(laneOf(v));
+                lanes.ampEnv.noteOff(laneOf(v));
+                lanes.pitchEnv.noteOff(laneOf(v));
+                voiceAllocator.noteReleased(v);
+            }
         }
     }
+}
 
-    // Update pitch envelope parameters in real-time (only if changed)
-    float envPitchAttack = apvts.getRawParameterValue("env_pitch_attack")->load();
-    float envPitchDecay = apvts.getRawParameterValue("env_pitch_decay")->load();
-    float envPitchSustain = apvts.getRawParameterValue("env_pitch_sustain")->load();
-    float envPitchRelease = apvts.getRawParameterValue("env_pitch_release")->load();
-    
-    if (envPitchAttack != cachedEnvPitchAttack || envPitchDecay != cachedEnvPitchDecay || 
-        envPitchSustain != cachedEnvPitchSustain || envPitchRelease != cachedEnvPitchRelease)
-    {
-        cachedEnvPitchAttack = envPitchAttack;
-        cachedEnvPitchDecay = envPitchDecay;
-        cachedEnvPitchSustain = envPitchSustain;
-        cachedEnvPitchRelease = envPitchRelease;
-        
-        juce::ADSR::Parameters pitchEnvParams;
-        pitchEnvParams.attack = envPitchAttack;
-        pitchEnvParams.decay = envPitchDecay;
-        pitchEnvParams.sustain = envPitchSustain;
-        pitchEnvParams.release = envPitchRelease;
-        monoPitchEnv.setParameters(pitchEnvParams);
-        
-        // Update poly mode per-voice pitch envelopes too
-        for (int i = 0; i < MAX_VOICES; ++i)
-        {
-            voices[i].pitchEnv.setParameters(pitchEnvParams);
-        }
-    }
-    
-    // === LFO RENDERING ===
-    // Update LFO1 parameters
-    float lfo1Rate = apvts.getRawParameterValue("lfo1_rate")->load();
-    bool lfo1SyncEnabled = (bool)*apvts.getRawParameterValue("lfo1_sync");
-    if (lfo1SyncEnabled)
-    {
-        int lfo1SyncVal = (int)*apvts.getRawParameterValue("lfo1_sync_val");
-        lfo1.rate = getSyncMultiplier(lfo1SyncVal) * 2.0f;  // Tempo-synced (2 Hz as base rate)
-    }
-    else
-    {
-        lfo1.rate = lfo1Rate;
-    }
-    lfo1.waveform = (int)*apvts.getRawParameterValue("lfo1_wave");
-    lfo1.pitchAmount = apvts.getRawParameterValue("lfo1_pitch")->load();
-    lfo1.filterAmount = apvts.getRawParameterValue("lfo1_filter")->load();
-    lfo1.ampAmount = apvts.getRawParameterValue("lfo1_amp")->load();
-    
-    // Update LFO2 parameters
-    float lfo2Rate = apvts.getRawParameterValue("lfo2_rate")->load();
-    bool lfo2SyncEnabled = (bool)*apvts.getRawParameterValue("lfo2_sync");
-    if (lfo2SyncEnabled)
+void Neon37AudioProcessor::renderSegment(int startSample, int numSamples, int voiceMode)
+{
+    // Nothing sounding: the segment stays silent without running oscillators, noise, filters or LFO waveforms
+    if (isSilent(voiceMode))
     {
-        int lfo2SyncVal = (int)*apvts.getRawParameterValue("lfo2_sync_val");
-        lfo2.rate = getSyncMultiplier(lfo2SyncVal) * 2.0f;  // Tempo-synced (2 Hz as base rate)
+        juce::FloatVectorOperations::clear(scratch.getMonoMix() + startSample, numSamples);
+        juce::FloatVectorOperations::clear(scratch.getLane(Neon37ScratchArena::ampEnvLane) + startSample, numSamples);
+        advanceLFOs(numSamples);
+        monoPitchGlide.skip(numSamples);
+        lastSegmentHadAnyActiveVoices = false;
+        return;
     }
-    else
-    {
-        lfo2.rate = lfo2Rate;
-    }
-    lfo2.waveform = (int)*apvts.getRawParameterValue("lfo2_wave");
-    lfo2.pitchAmount = apvts.getRawParameterValue("lfo2_pitch")->load();
-    lfo2.filterAmount = apvts.getRawParameterValue("lfo2_filter")->load();
-    lfo2.ampAmount = apvts.getRawParameterValue("lfo2_amp")->load();
-    
-    // Check if mod wheel scaling is enabled
-    modWheelEnabled = (bool)*apvts.getRawParameterValue("mw_enable");
-    float modWheelScale = modWheelEnabled ? modWheelValue : 1.0f;
-    
-    // Advance LFO phases for this block and generate waveforms
-    float phaseIncrement1 = (lfo1.rate / (float)currentSampleRate) * juce::MathConstants<float>::twoPi;
-    float phaseIncrement2 = (lfo2.rate / (float)currentSampleRate) * juce::MathConstants<float>::twoPi;
-    
-    lfo1.phase += phaseIncrement1 * buffer.getNumSamples();
-    lfo2.phase += phaseIncrement2 * buffer.getNumSamples();
-    
-    // Wrap phases to [0, 2π)
-    while (lfo1.phase >= juce::MathConstants<float>::twoPi)
-        lfo1.phase -= juce::MathConstants<float>::twoPi;
-    while (lfo2.phase >= juce::MathConstants<float>::twoPi)
-        lfo2.phase -= juce::MathConstants<float>::twoPi;
-    
-    // Generate LFO waveforms (output range: -1 to +1, representing -100% to +100%)
-    float lfo1Output = generateLFOWaveform(lfo1.phase, lfo1.waveform);
-    float lfo2Output = generateLFOWaveform(lfo2.phase, lfo2.waveform);
-    
-    // Calculate modulation amounts (all scaled by mod wheel if enabled)
-    // LFO output is bipolar: -1 to +1 representing -100% to +100%
-    float lfoPitchMod = lfo1Output * lfo1.pitchAmount + lfo2Output * lfo2.pitchAmount;
-    float lfoFilterMod = lfo1Output * lfo1.filterAmount + lfo2Output * lfo2.filterAmount;
-    float lfoAmpMod = lfo1Output * lfo1.ampAmount + lfo2Output * lfo2.ampAmount;
     
     // === CALCULATE ALL MODULATIONS (refactored into helper) ===
+    // Recomputed per segment so velocity/aftertouch/bend/mod wheel changes land on their sample
     ModulationState modState;
-    calculateAllModulations(modState, lfoFilterMod, lfoPitchMod, lfoAmpMod, modWheelScale);
+    calculateAllModulations(modState, voiceMode);
     
-    float totalPitchModSemitones = modState.pitchModSemitones;
-    float totalFilterModMultiplier = modState.totalFilterModMultiplier;
-    float totalAmpModMultiplier = modState.totalAmpModMultiplier;
+    // === LFO RENDERING ===
+    // Per sample for the segment, so the modulation does not depend on where the block or
+    // segment boundaries fall (scaled by the mod wheel if enabled)
+    float modWheelScale = modWheelEnabled ? modWheelValue : 1.0f;
+    renderLFOs(startSample, numSamples, modWheelScale, modState);
     
-    // Get oscillator parameters
-    int osc1Wave = (int)*apvts.getRawParameterValue("osc1_wave");
-    int osc1Octave = (int)*apvts.getRawParameterValue("osc1_octave");
-    int osc1Semitones = (int)*apvts.getRawParameterValue("osc1_semitones");
-    float osc1Fine = apvts.getRawParameterValue("osc1_fine")->load();
-    
-    int osc2Wave = (int)*apvts.getRawParameterValue("osc2_wave");
-    int osc2Octave = (int)*apvts.getRawParameterValue("osc2_octave");
-    int osc2Semitones = (int)*apvts.getRawParameterValue("osc2_semitones");
-    float osc2Fine = apvts.getRawParameterValue("osc2_fine")->load();
-    
-    // Get mixer levels from parameters (in dB, so convert to linear)
-    float mixerOsc1Db = apvts.getRawParameterValue("mixer_osc1")->load();
-    float mixerOsc2Db = apvts.getRawParameterValue("mixer_osc2")->load();
-    float mixerSub1Db = apvts.getRawParameterValue("mixer_sub1")->load();
-    
-    float mixerOsc1 = juce::Decibels::decibelsToGain(mixerOsc1Db);
-    float mixerOsc2 = juce::Decibels::decibelsToGain(mixerOsc2Db);
-    float mixerSub1 = juce::Decibels::decibelsToGain(mixerSub1Db);
-    float mixerNoiseDb = apvts.getRawParameterValue("mixer_noise")->load();
-    float mixerNoise = juce::Decibels::decibelsToGain(mixerNoiseDb);
-
-    // Hard Sync
-    bool hardSync = (bool)*apvts.getRawParameterValue("hard_sync");
+    if (voiceMode == 0 || voiceMode == 1)  // MONO or MONO-L rendering
+        renderMonoSegment(startSample, numSamples, modState);
+    else if (voiceMode == 2 || voiceMode == 3)  // Paraphonic rendering (modes 2, 3)
+        renderParaphonicSegment(startSample, numSamples, modState);
+    else if (voiceMode == 4)  // Poly mode: full per-voice signal chain
+        renderPolySegment(startSample, numSamples, modState);
+}
 
-    // Pitch Envelope Parameters
-    float pitchEgDepth = apvts.getRawParameterValue("env_pitch_depth")->load();
-    int pitchEgTarget = (int)*apvts.getRawParameterValue("env_pitch_target"); // 0: Osc1, 1: Both, 2: Osc2
-    
-    // Global oscillator level scaling to prevent overdrive (-12dB to keep headroom)
-    constexpr float oscLevelScale = 0.25f;
-    mixerOsc1 *= oscLevelScale;
-    mixerOsc2 *= oscLevelScale;
-    mixerSub1 *= oscLevelScale;
-    mixerNoise *= oscLevelScale;
-    
-    // Get filter parameters
-    float baseCutoff = apvts.getRawParameterValue("cutoff")->load();
-    float resonance = apvts.getRawParameterValue("resonance")->load();
-    float egDepth = apvts.getRawParameterValue("eg_depth")->load();
-    float drive = apvts.getRawParameterValue("drive")->load();
+void Neon37AudioProcessor::renderMonoSegment(int startSample, int numSamples, const ModulationState& modState)
+{
+    const int endSample = startSample + numSamples;
+    float* monoMix = scratch.getMonoMix();
+    float* ampEnvBuffer = scratch.getLane(Neon37ScratchArena::ampEnvLane);
     
-    // Get master volume
-    float masterVolDb = apvts.getRawParameterValue("master_volume")->load();
-    float masterVol = juce::Decibels::decibelsToGain(masterVolDb);
+    // White noise for the whole segment in one pass
+    float* noiseBuffer = scratch.getLane(Neon37ScratchArena::noiseLane);
+    noise.fill(noiseBuffer + startSample, numSamples);
     
-    // Create a working buffer for synthesis
-    juce::AudioBuffer<float> synthBuffer(totalNumOutputChannels, buffer.getNumSamples());
-    synthBuffer.clear();
+    // Get oscillator parameters
+    int osc1Wave = params.osc1Wave;
+    int osc2Wave = params.osc2Wave;
+    float osc1Morph = params.osc1Morph;
+    float osc2Morph = params.osc2Morph;
     
-    // Create buffer for amplitude envelope values
-    juce::AudioBuffer<float> ampEnvBuffer(1, buffer.getNumSamples());
-    ampEnvBuffer.clear();
+    // Mixer levels (linear, cached; already include the global oscillator level scaling)
+    const float mixerOsc1 = derived.mixerOsc1;
+    const float mixerOsc2 = derived.mixerOsc2;
+    const float mixerSub1 = derived.mixerSub1;
+    const float mixerNoise = derived.mixerNoise;
     
-    // Generate and mix oscillators
-    float twoPiOverSr = juce::MathConstants<float>::twoPi / (float)currentSampleRate;
-
-    // Precompute constant ratios for this block
-    const float totalPitchModRatio = std::pow(2.0f, totalPitchModSemitones / 12.0f);
-    const float osc1Ratio = std::pow(2.0f, (float)osc1Octave) * std::pow(2.0f, (float)osc1Semitones / 12.0f) * std::pow(2.0f, osc1Fine / 12.0f);
-    const float osc2Ratio = std::pow(2.0f, (float)osc2Octave) * std::pow(2.0f, (float)osc2Semitones / 12.0f) * std::pow(2.0f, osc2Fine / 12.0f);
+    // Hard Sync
+    bool hardSync = params.hardSync;
     
-    if (voiceMode == 0 || voiceMode == 1)  // MONO or MONO-L rendering
+    // Get filter parameters
+    float baseCutoff = params.cutoff;
+    float resonance = params.resonance;
+    float egDepth = params.egDepth;
+    float drive = params.drive;
+    
+    // Pitch is summed in log2 domain (glide in log2 Hz + modulation + tuning + pitch EG, all in octaves)
+    // and converted with one exp2 per oscillator per sample; the offsets below fold in log2(1 / sampleRate)
+    // so the result is the phase increment in cycles per sample
+    const float pitchToIncrement = modState.pitchModSemitones / 12.0f - Neon37FastMath::log2((float)currentSampleRate);
+    const float osc1PitchOffset = pitchToIncrement + derived.osc1Octaves;
+    const float osc2PitchOffset = pitchToIncrement + derived.osc2Octaves;
+    const float osc1PitchEgOctaves = derived.modMatrix.getAmount(Neon37ModulationMatrix::pitchEnvelope, Neon37ModulationMatrix::osc1Pitch) / 12.0f;
+    const float osc2PitchEgOctaves = derived.modMatrix.getAmount(Neon37ModulationMatrix::pitchEnvelope, Neon37ModulationMatrix::osc2Pitch) / 12.0f;
+    
+    // Unison stack replaces the single oscillator set (unison_voices > 1)
+    const OscillatorSettings oscillators = getOscillatorSettings();
+    const OscillatorSettings* unisonOscillators = derived.unisonCount > 1 ? &oscillators : nullptr;
+    
+    // Envelopes for the whole segment, with all amplitude modulations (LFO, velocity, aftertouch)
+    // applied to the amp envelope
+    float* filterEnvBuffer = scratch.getLane(Neon37ScratchArena::filterEnvLane);
+    float* pitchEnvBuffer = scratch.getLane(Neon37ScratchArena::pitchEnvLane);
+    monoFilterEnv.process(filterEnvBuffer + startSample, numSamples);
+    monoPitchEnv.process(pitchEnvBuffer + startSample, numSamples);
+    monoAmpEnv.process(ampEnvBuffer + startSample, numSamples);
+    applyAmpModulation(ampEnvBuffer, startSample, numSamples, modState);
+    
+    // Render in control-rate sub-blocks: audio runs per sample, the filter is retuned once per
+    // sub-block and ramps to the new cutoff across it
+    for (int subStart = startSample; subStart < endSample; subStart += controlBlockSize)
     {
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        const int subEnd = juce::jmin(endSample, subStart + controlBlockSize);
+        
+        for (int sample = subStart; sample < subEnd; ++sample)
         {
             // Sample-accurate portamento: advance SmoothedValue every sample
-            const float baseFreq = monoPitchGlide.getNextValue();
-
-            // Apply all pitch modulations (LFO, velocity, aftertouch, pitch bend)
-            const float lfoModFreq = baseFreq * totalPitchModRatio;
-
-            const float osc1FreqBase = lfoModFreq * osc1Ratio;
-            const float osc2FreqBase = lfoModFreq * osc2Ratio;
-
-            // Get envelope values
-            float filterEnvValue = monoFilterEnv.getNextSample();
-            float ampEnvValue = monoAmpEnv.getNextSample();
-            float pitchEnvValue = monoPitchEnv.getNextSample();
-
-            ampEnvBuffer.setSample(0, sample, ampEnvValue);
+            const float glidePitch = monoPitchGlide.getNextValue() + modState.lfoPitchOctaves[sample];
+            const float pitchEnvValue = pitchEnvBuffer[sample];
             
-            // Calculate Pitch EG modification
-            float pitchEgMod = pitchEnvValue * pitchEgDepth; // Semitones
-            float osc1PitchMod = (pitchEgTarget == 0 || pitchEgTarget == 1) ? pitchEgMod : 0.0f;
-            float osc2PitchMod = (pitchEgTarget == 2 || pitchEgTarget == 1) ? pitchEgMod : 0.0f;
-
-            // Calculate current sample frequency with Pitch EG
-            float currentOsc1Freq = osc1FreqBase * std::pow(2.0f, osc1PitchMod / 12.0f);
-            float currentOsc2Freq = osc2FreqBase * std::pow(2.0f, osc2PitchMod / 12.0f);
-            float currentSubFreq = currentOsc1Freq * 0.5f;
-
-            // Calculate and apply modulated cutoff
-            float modulatedCutoff = calculateModulatedCutoff(baseCutoff, filterEnvValue, egDepth, totalFilterModMultiplier, resonance);
-            monoFilter.setCutoffFrequencyHz(modulatedCutoff);
-            monoFilter.setResonance(resonance);
-            monoFilter.setDrive(drive);
+            const float noiseSample = noiseBuffer[sample] * mixerNoise;
+            
+            if (unisonOscillators != nullptr)
+            {
+                // Unison: the voice's stack of detuned copies replaces the single oscillator set
+                monoMix[sample] = renderUnisonSample(monoUnison, glidePitch + osc1PitchOffset + pitchEnvValue * osc1PitchEgOctaves,
+                                                     glidePitch + osc2PitchOffset + pitchEnvValue * osc2PitchEgOctaves, *unisonOscillators)
+                                + noiseSample;
+                continue;
+            }
+            
+            // Phase increments (cycles) with all pitch modulations and the pitch EG; the sub divides osc 1 by two
+            const float osc1Increment = Neon37FastMath::exp2(glidePitch + osc1PitchOffset + pitchEnvValue * osc1PitchEgOctaves);
+            const float osc2Increment = Neon37FastMath::exp2(glidePitch + osc2PitchOffset + pitchEnvValue * osc2PitchEgOctaves);
+            const float subIncrement = osc1Increment * 0.5f;
+            const float subPhase = Neon37Phase::toCycles(Neon37Phase::divideByTwo(osc1Phase, subOscBit));
             
             // Generate oscillator samples
-            float osc1Sample = generateWaveform(osc1Phase, osc1Wave) * mixerOsc1;
-            float osc2Sample = generateWaveform(osc2Phase, osc2Wave) * mixerOsc2;
-            float subSample = generateWaveform(subOscPhase, 2) * mixerSub1;
-            float noiseSample = (random.nextFloat() * 2.0f - 1.0f) * mixerNoise;
+            float osc1Sample = generateWaveform(Neon37Phase::toCycles(osc1Phase), osc1Increment, osc1Wave, osc1Morph) * mixerOsc1;
+            float osc2Sample = generateWaveform(Neon37Phase::toCycles(osc2Phase), osc2Increment, osc2Wave, osc2Morph) * mixerOsc2;
+            float subSample = generateWaveform(subPhase, subIncrement, Neon37PolyBLEP::square, 0.0f) * mixerSub1;
             
             float mixed = osc1Sample + osc2Sample + subSample + noiseSample;
             
-            for (int channel = 0; channel < totalNumOutputChannels; ++channel)
-            {
-                synthBuffer.setSample(channel, sample, mixed);
-            }
+            monoMix[sample] = mixed;
+            
+            // Update phases (the accumulators wrap on overflow); an osc 1 carry flips the sub and syncs osc 2
+            const uint32_t previousOsc1Phase = osc1Phase;
+            osc1Phase += Neon37Phase::fromCycles(osc1Increment);
+            osc2Phase += Neon37Phase::fromCycles(osc2Increment);
             
-            // Update phases
-            osc1Phase += twoPiOverSr * currentOsc1Freq;
-            osc2Phase += twoPiOverSr * currentOsc2Freq;
-            subOscPhase += twoPiOverSr * currentSubFreq;
-             
-            // Wrap phases
-            if (osc1Phase > juce::MathConstants<float>::twoPi) 
+            if (osc1Phase < previousOsc1Phase)
             {
-                osc1Phase -= juce::MathConstants<float>::twoPi;
+                subOscBit ^= Neon37Phase::subOctaveBit;
                 if (hardSync)
-                    osc2Phase = 0.0f;
+                    osc2Phase = 0;
             }
-            if (osc2Phase > juce::MathConstants<float>::twoPi) osc2Phase -= juce::MathConstants<float>::twoPi;
-            if (subOscPhase > juce::MathConstants<float>::twoPi) subOscPhase -= juce::MathConstants<float>::twoPi;
         }
+        
+        // Calculate modulated cutoff at the end of this sub-block and filter it
+        float modulatedCutoff = calculateModulatedCutoff(baseCutoff, filterEnvBuffer[subEnd - 1], egDepth, modState.filterModMultiplierAt(subEnd - 1), resonance);
+        processMonoFilterSubBlock(subStart, subEnd - subStart, modulatedCutoff, resonance, drive);
     }
-    else if (voiceMode == 2 || voiceMode == 3)  // Paraphonic rendering (modes 2, 3)
-    {
-        // Generate Pitch Envelope for this block (shared for all voices in Paraphonic)
-        juce::AudioBuffer<float> pitchEnvBuffer(1, buffer.getNumSamples());
-        for (int s = 0; s < buffer.getNumSamples(); ++s)
-        {
-            pitchEnvBuffer.setSample(0, s, monoPitchEnv.getNextSample());
-        }
+    
+    cullMonoEnvelopes();
+}
 
-        // Handle note-offs for paraphonic mode
-        for (int note : releasedNotes)
-        {
-            for (int i = 0; i < MAX_VOICES; ++i)
-            {
-                if (voices[i].active && voices[i].midiNote == note)
-                {
-                    voices[i].ampGate.noteOff();
-                    break;
-                }
-            }
-        }
-        
-        // Track if any voice is still active before processing this block
-        bool anyVoiceActiveBefore = false;
-        int activeVoiceCount = 0;
-        for (int i = 0; i < MAX_VOICES; ++i)
+void Neon37AudioProcessor::renderParaphonicSegment(int startSample, int numSamples, const ModulationState& modState)
+{
+    const int endSample = startSample + numSamples;
+    float* monoMix = scratch.getMonoMix();
+    float* ampEnvBuffer = scratch.getLane(Neon37ScratchArena::ampEnvLane);
+    
+    // White noise for the whole segment in one pass
+    float* noiseBuffer = scratch.getLane(Neon37ScratchArena::noiseLane);
+    noise.fill(noiseBuffer + startSample, numSamples);
+    
+    // Get oscillator parameters
+    int osc1Wave = params.osc1Wave;
+    int osc2Wave = params.osc2Wave;
+    float osc1Morph = params.osc1Morph;
+    float osc2Morph = params.osc2Morph;
+    
+    // Mixer levels (linear, cached; already include the global oscillator level scaling)
+    const float mixerOsc1 = derived.mixerOsc1;
+    const float mixerOsc2 = derived.mixerOsc2;
+    const float mixerSub1 = derived.mixerSub1;
+    const float mixerNoise = derived.mixerNoise;
+    
+    // Hard Sync
+    bool hardSync = params.hardSync;
+    
+    // Get filter parameters
+    float baseCutoff = params.cutoff;
+    float resonance = params.resonance;
+    float egDepth = params.egDepth;
+    float drive = params.drive;
+    
+    // Pitch is summed in log2 domain per lane (glide in log2 Hz + modulation + tuning + pitch EG, all in
+    // octaves) and converted with one exp2 per oscillator; the offsets fold in log2(1 / sampleRate) so the
+    // result is the phase increment in cycles per sample
+    const float pitchToIncrement = modState.pitchModSemitones / 12.0f - Neon37FastMath::log2((float)currentSampleRate);
+    const float osc1PitchOffset = pitchToIncrement + derived.osc1Octaves;
+    const float osc2PitchOffset = pitchToIncrement + derived.osc2Octaves;
+    const float osc1PitchEgOctaves = derived.modMatrix.getAmount(Neon37ModulationMatrix::pitchEnvelope, Neon37ModulationMatrix::osc1Pitch) / 12.0f;
+    const float osc2PitchEgOctaves = derived.modMatrix.getAmount(Neon37ModulationMatrix::pitchEnvelope, Neon37ModulationMatrix::osc2Pitch) / 12.0f;
+    
+    // Track if any voice is still active before processing this segment
+    bool anyVoiceActiveBefore = false;
+    for (int i = 0; i < MAX_VOICES; ++i)
+    {
+        if (voices[i].active)
         {
-            if (voices[i].active)
-            {
-                anyVoiceActiveBefore = true;
-                ++activeVoiceCount;
-            }
+            anyVoiceActiveBefore = true;
+            break;
         }
+    }
+    
+    // Shared pitch envelope (Paraphonic): rendered once for the segment, read by every voice group
+    float* pitchEnvBuffer = scratch.getLane(Neon37ScratchArena::pitchEnvLane);
+    monoPitchEnv.process(pitchEnvBuffer + startSample, numSamples);
+    
+    // Note: In paraphonic mode, the shared amplitude envelope controls overall volume,
+    // so voices are not scaled down by voice count. This maintains consistent
+    // envelope behavior regardless of note count.
+    using LaneArray = Neon37VoiceLanes::LaneArray;
+    alignas(32) LaneArray osc1Increment, osc2Increment, subIncrement, osc1Out, osc2Out, subOut;
+    alignas(32) LaneArray osc1Cycles, osc2Cycles, subCycles;
+    alignas(32) Neon37VoiceLanes::PhaseArray osc1Step, osc2Step;
+    
+    // Unison stacks replace the voices' single oscillator sets (unison_voices > 1)
+    const OscillatorSettings oscillators = getOscillatorSettings();
+    const OscillatorSettings* unisonOscillators = derived.unisonCount > 1 ? &oscillators : nullptr;
+    
+    // Render each group holding an active voice, all its lanes together one sample at a time;
+    // each lane's gate (1 while its key is held, 0 otherwise) masks the lanes that should be silent
+    for (int g = 0; g < NUM_VOICE_GROUPS; ++g)
+    {
+        if (!isGroupActive(g))
+            continue;
         
-        // Calculate voice scaling to prevent overdrive from multiple voices mixing
-        // Note: In paraphonic mode, the shared amplitude envelope controls overall volume,
-        // so voices should not be scaled down by voice count. This maintains consistent
-        // envelope behavior regardless of note count.
-        float voiceGain = 1.0f;  // No scaling - envelope handles volume control
+        auto& lanes = voiceGroups[(size_t)g].lanes;
         
-        // Render each active voice
-        for (int voiceIdx = 0; voiceIdx < MAX_VOICES; ++voiceIdx)
+        for (int sample = startSample; sample < endSample; ++sample)
         {
-            if (!voices[voiceIdx].active)
-                continue;
+            // One pitch offset per oscillator for every voice (shared pitch envelope)
+            const float osc1Pitch = osc1PitchOffset + modState.lfoPitchOctaves[sample] + pitchEnvBuffer[sample] * osc1PitchEgOctaves;
+            const float osc2Pitch = osc2PitchOffset + modState.lfoPitchOctaves[sample] + pitchEnvBuffer[sample] * osc2PitchEgOctaves;
             
-            // Render voice's oscillators to voiceBuffer
-            voices[voiceIdx].voiceBuffer.clear();
+            // Sample-accurate pitch for every voice
+            lanes.advanceGlide();
             
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            if (unisonOscillators != nullptr)
             {
-                // Sample-accurate pitch for this voice
-                const float voiceBaseFreq = voices[voiceIdx].pitchGlide.getNextValue();
-                const float voiceLfoModFreq = voiceBaseFreq * totalPitchModRatio;
-                const float voiceOsc1FreqBase = voiceLfoModFreq * osc1Ratio;
-                const float voiceOsc2FreqBase = voiceLfoModFreq * osc2Ratio;
-
-                // Calculate Pitch EG modification
-                float pitchEnvValue = pitchEnvBuffer.getSample(0, sample);
-                float pitchEgMod = pitchEnvValue * pitchEgDepth; // Semitones
-                float osc1PitchMod = (pitchEgTarget == 0 || pitchEgTarget == 1) ? pitchEgMod : 0.0f;
-                float osc2PitchMod = (pitchEgTarget == 2 || pitchEgTarget == 1) ? pitchEgMod : 0.0f;
-
-                // Calculate current sample frequency with Pitch EG
-                float currentVoiceOsc1Freq = voiceOsc1FreqBase * std::pow(2.0f, osc1PitchMod / 12.0f);
-                float currentVoiceOsc2Freq = voiceOsc2FreqBase * std::pow(2.0f, osc2PitchMod / 12.0f);
-                float currentVoiceSubFreq = currentVoiceOsc1Freq * 0.5f;
-
-                // Generate oscillator samples for this voice
-                float osc1Sample = generateWaveform(voices[voiceIdx].osc1Phase, osc1Wave) * mixerOsc1;
-                float osc2Sample = generateWaveform(voices[voiceIdx].osc2Phase, osc2Wave) * mixerOsc2;
-                float subSample = generateWaveform(voices[voiceIdx].subOscPhase, 2) * mixerSub1;
-                
-                float mixed = (osc1Sample + osc2Sample + subSample);
-                
-                // Apply voice's amp gate (gates the oscillators on/off)
-                float gateValue = voices[voiceIdx].ampGate.getNextSample();
-                mixed *= gateValue;
-                
-                for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+                // Unison: each gated voice renders its own stack of detuned copies
+                float mixed = 0.0f;
+                for (int v = 0; v < VOICE_LANES; ++v)
                 {
-                    voices[voiceIdx].voiceBuffer.addSample(channel, sample, mixed);
+                    if (lanes.gate[(size_t)v] != 0.0f)
+                        mixed += lanes.gate[(size_t)v] * renderUnisonSample(voiceGroups[(size_t)g].unison[(size_t)v], lanes.glideCurrent[(size_t)v] + osc1Pitch,
+                                                                            lanes.glideCurrent[(size_t)v] + osc2Pitch, *unisonOscillators);
                 }
                 
-                // Update voice's oscillator phases
-                voices[voiceIdx].osc1Phase += twoPiOverSr * currentVoiceOsc1Freq;
-                voices[voiceIdx].osc2Phase += twoPiOverSr * currentVoiceOsc2Freq;
-                voices[voiceIdx].subOscPhase += twoPiOverSr * currentVoiceSubFreq;
-                
-                // Wrap phases
-                if (voices[voiceIdx].osc1Phase > juce::MathConstants<float>::twoPi) 
-                {
-                    voices[voiceIdx].osc1Phase -= juce::MathConstants<float>::twoPi;
-                    if (hardSync)
-                        voices[voiceIdx].osc2Phase = 0.0f;
-                }
-                if (voices[voiceIdx].osc2Phase > juce::MathConstants<float>::twoPi) voices[voiceIdx].osc2Phase -= juce::MathConstants<float>::twoPi;
-                if (voices[voiceIdx].subOscPhase > juce::MathConstants<float>::twoPi) voices[voiceIdx].subOscPhase -= juce::MathConstants<float>::twoPi;
+                monoMix[sample] += mixed;
+                continue;
             }
             
-            // Mix this voice's buffer to synthesis buffer
-            for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+            for (int v = 0; v < VOICE_LANES; ++v)
             {
-                synthBuffer.addFrom(channel, 0, voices[voiceIdx].voiceBuffer, channel, 0, buffer.getNumSamples(), voiceGain);
+                osc1Increment[(size_t)v] = Neon37FastMath::exp2(lanes.glideCurrent[(size_t)v] + osc1Pitch);
+                osc2Increment[(size_t)v] = Neon37FastMath::exp2(lanes.glideCurrent[(size_t)v] + osc2Pitch);
+                subIncrement[(size_t)v] = osc1Increment[(size_t)v] * 0.5f;
+                osc1Step[(size_t)v] = Neon37Phase::fromCycles(osc1Increment[(size_t)v]);
+                osc2Step[(size_t)v] = Neon37Phase::fromCycles(osc2Increment[(size_t)v]);
             }
             
-            // Mark voice inactive if gate is fully released
-            if (!voices[voiceIdx].ampGate.isActive())
-            {
-                voices[voiceIdx].active = false;
-            }
+            lanes.getPhases(osc1Cycles.data(), osc2Cycles.data(), subCycles.data());
+            renderOscillatorLanes(osc1Wave, osc1Morph, osc1Cycles.data(), osc1Increment.data(), osc1Out.data());
+            renderOscillatorLanes(osc2Wave, osc2Morph, osc2Cycles.data(), osc2Increment.data(), osc2Out.data());
+            renderOscillatorLanes(Neon37PolyBLEP::square, 0.0f, subCycles.data(), subIncrement.data(), subOut.data());
+            
+            float mixed = 0.0f;
+            for (int v = 0; v < VOICE_LANES; ++v)
+                mixed += lanes.gate[(size_t)v] * (osc1Out[(size_t)v] * mixerOsc1 + osc2Out[(size_t)v] * mixerOsc2 + subOut[(size_t)v] * mixerSub1);
+            
+            monoMix[sample] += mixed;
+            
+            lanes.advancePhases(osc1Step.data(), osc2Step.data(), hardSync);
         }
-        
-        // Check if all voices just became inactive (transition from at least one active to all inactive)
-        bool anyVoiceActiveAfter = false;
-        for (int i = 0; i < MAX_VOICES; ++i)
+    }
+    
+    // Mark voices inactive once their gate has closed
+    for (int i = 0; i < MAX_VOICES; ++i)
+    {
+        if (voices[i].active && groupOf(i).lanes.gate[(size_t)laneOf(i)] == 0.0f)
+            freeVoice(i);
+    }
+    
+    // Check if all voices just became inactive (transition from at least one active to all inactive)
+    bool anyVoiceActiveAfter = false;
+    for (int i = 0; i < MAX_VOICES; ++i)
+    {
+        if (voices[i].active)
         {
-            if (voices[i].active)
-            {
-                anyVoiceActiveAfter = true;
-                break;
-            }
+            anyVoiceActiveAfter = true;
+            break;
         }
+    }
+    
+    // When last voice becomes inactive, trigger envelope release
+    if (anyVoiceActiveBefore && !anyVoiceActiveAfter)
+    {
+        monoFilterEnv.noteOff();
+        monoAmpEnv.noteOff();
+    }
+    
+    // Update tracking flag for the next note-on's retrigger logic
+    lastSegmentHadAnyActiveVoices = anyVoiceActiveAfter;
+    
+    // Shared filter and amp envelopes for the segment (after the gates above, so a release
+    // triggered by the last voice lands here); continue as long as they are active (releasing).
+    // The amp envelope carries all amplitude modulations (LFO, velocity, aftertouch).
+    float* filterEnvBuffer = scratch.getLane(Neon37ScratchArena::filterEnvLane);
+    monoFilterEnv.process(filterEnvBuffer + startSample, numSamples);
+    monoAmpEnv.process(ampEnvBuffer + startSample, numSamples);
+    applyAmpModulation(ampEnvBuffer, startSample, numSamples, modState);
+    
+    // Add Noise
+    juce::FloatVectorOperations::addWithMultiply(monoMix + startSample, noiseBuffer + startSample, mixerNoise, numSamples);
+    
+    // Filter in control-rate sub-blocks, with the cutoff from the filter envelope at the end of each
+    for (int subStart = startSample; subStart < endSample; subStart += controlBlockSize)
+    {
+        const int subEnd = juce::jmin(endSample, subStart + controlBlockSize);
+        float modulatedCutoff = calculateModulatedCutoff(baseCutoff, filterEnvBuffer[subEnd - 1], egDepth, modState.filterModMultiplierAt(subEnd - 1), resonance);
+        processMonoFilterSubBlock(subStart, subEnd - subStart, modulatedCutoff, resonance, drive);
+    }
+    
+    cullMonoEnvelopes();
+}
+
+void Neon37AudioProcessor::renderPolySegment(int startSample, int numSamples, const ModulationState& modState)
+{
+    float* monoMix = scratch.getMonoMix();
+    
+    PolySegmentSettings settings;
+    settings.startSample = startSample;
+    settings.endSample = startSample + numSamples;
+    
+    // Oscillator waveforms, mixer levels (linear, cached; already include the global oscillator
+    // level scaling) and hard sync
+    settings.oscillators = getOscillatorSettings();
+    settings.mixerNoise = derived.mixerNoise;
+    
+    // Get filter parameters
+    settings.baseCutoff = params.cutoff;
+    settings.resonance = params.resonance;
+    settings.egDepth = params.egDepth;
+    settings.drive = params.drive;
+    
+    // Pitch is summed in log2 domain per lane (glide in log2 Hz + modulation + tuning + pitch EG, all in
+    // octaves) and converted with one exp2 per oscillator; the offsets fold in log2(1 / sampleRate) so the
+    // result is the phase increment in cycles per sample
+    const float pitchToIncrement = modState.pitchModSemitones / 12.0f - Neon37FastMath::log2((float)currentSampleRate);
+    settings.osc1PitchOffset = pitchToIncrement + derived.osc1Octaves;
+    settings.osc2PitchOffset = pitchToIncrement + derived.osc2Octaves;
+    settings.osc1PitchEgOctaves = derived.modMatrix.getAmount(Neon37ModulationMatrix::pitchEnvelope, Neon37ModulationMatrix::osc1Pitch) / 12.0f;
+    settings.osc2PitchEgOctaves = derived.modMatrix.getAmount(Neon37ModulationMatrix::pitchEnvelope, Neon37ModulationMatrix::osc2Pitch) / 12.0f;
+    
+    settings.filterMod = modState.filterMod;
+    settings.ampMod = modState.ampMod;
+    settings.lfoPitchOctaves = modState.lfoPitchOctaves;
+    settings.lfoFilterMod = modState.lfoFilterMod;
+    settings.lfoAmpMod = modState.lfoAmpMod;
+    
+    // Render only the groups holding an active voice (cost scales with the voices in use, not the pool size)
+    std::array<int, NUM_VOICE_GROUPS> activeGroups;
+    int numActiveGroups = 0;
+    for (int g = 0; g < NUM_VOICE_GROUPS; ++g)
+    {
+        if (isGroupActive(g))
+            activeGroups[(size_t)numActiveGroups++] = g;
+    }
+    
+    if (voiceWorkers.getNumWorkers() > 0 && numActiveGroups >= MIN_PARALLEL_GROUPS && numSamples >= MIN_PARALLEL_SAMPLES)
+    {
+        // Each group renders into its own buffers on whichever thread claims it, then the group
+        // mixes are summed in group order: the same additions in the same order as the
+        // single-threaded path, so the output is identical
+        PolyGroupJobs jobs { this, &settings, activeGroups.data() };
+        voiceWorkers.run(renderPolyGroupJob, &jobs, numActiveGroups);
         
-        // When last voice becomes inactive, trigger envelope release
-        if (anyVoiceActiveBefore && !anyVoiceActiveAfter)
-        {
-            monoFilterEnv.noteOff();
-            monoAmpEnv.noteOff();
-        }
+        for (int i = 0; i < numActiveGroups; ++i)
+            juce::FloatVectorOperations::add(monoMix + startSample, scratch.getVoiceMix(activeGroups[(size_t)i]) + startSample, numSamples);
+    }
+    else
+    {
+        for (int i = 0; i < numActiveGroups; ++i)
+            renderPolyGroup(activeGroups[(size_t)i], settings, scratch.getVoiceFrames(), monoMix);
+    }
+    
+    // Free voices whose amp envelope has ended. A voice fading below cull_floor (release, or a
+    // decay to a lower sustain) is stopped early: the rest of its tail is inaudible.
+    for (int v = 0; v < MAX_VOICES; ++v)
+    {
+        if (!voices[v].active)
+            continue;
         
-        // Generate envelope values for paraphonic mode
-        // Continue processing as long as envelopes are still active (releasing)
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        auto& lanes = groupOf(v).lanes;
+        const int lane = laneOf(v);
+        if (lanes.ampEnv.isBelow(lane, derived.cullFloor))
         {
-            float filterEnvValue = monoFilterEnv.getNextSample();
-            float ampEnvValue = monoAmpEnv.getNextSample();
-            ampEnvBuffer.setSample(0, sample, ampEnvValue);
-            
-            // Calculate and apply modulated cutoff
-            float modulatedCutoff = calculateModulatedCutoff(baseCutoff, filterEnvValue, egDepth, totalFilterModMultiplier, resonance);
-            monoFilter.setCutoffFrequencyHz(modulatedCutoff);
-            monoFilter.setResonance(resonance);
-            monoFilter.setDrive(drive);
-
-            // Add Noise
-            float noiseSample = (random.nextFloat() * 2.0f - 1.0f) * mixerNoise;
-            for (int channel = 0; channel < totalNumOutputChannels; ++channel)
-            {
-                synthBuffer.addSample(channel, sample, noiseSample);
-            }
+            lanes.ampEnv.reset(lane);
+            lanes.filterEnv.reset(lane);
+            lanes.pitchEnv.reset(lane);
         }
         
-        // Update tracking flag for next block's retrigger logic
-        lastBlockHadAnyActiveVoices = anyVoiceActiveAfter;
+        if (!lanes.ampEnv.isActive(lane))
+            freeVoice(v);
     }
-    else if (voiceMode == 4)  // Poly mode: full per-voice signal chain
+}
+
+void Neon37AudioProcessor::renderPolyGroupJob(void* context, int job)
+{
+    const auto& jobs = *static_cast<const PolyGroupJobs*>(context);
+    const int g = jobs.groups[job];
+    auto& scratch = jobs.processor->scratch;
+    const auto& settings = *jobs.settings;
+    
+    float* mix = scratch.getVoiceMix(g);
+    juce::FloatVectorOperations::clear(mix + settings.startSample, settings.endSample - settings.startSample);
+    jobs.processor->renderPolyGroup(g, settings, scratch.getVoiceFrames(g), mix);
+}
+
+void Neon37AudioProcessor::renderPolyGroup(int g, const PolySegmentSettings& settings, float* voiceFrames, float* mix)
+{
+    const int startSample = settings.startSample;
+    const int endSample = settings.endSample;
+    
+    using LaneArray = Neon37VoiceLanes::LaneArray;
+    alignas(32) LaneArray pitchEnvValues, filterEnvValues, ampEnvValues, noiseValues;
+    alignas(32) LaneArray osc1Increment, osc2Increment, subIncrement, osc1Out, osc2Out, subOut;
+    alignas(32) LaneArray osc1Cycles, osc2Cycles, subCycles;
+    alignas(32) Neon37VoiceLanes::PhaseArray osc1Step, osc2Step;
+    
+    auto& group = voiceGroups[(size_t)g];
+    auto& lanes = group.lanes;
+    const Neon37Voice* groupVoices = voices.data() + g * VOICE_LANES;
+    const OscillatorSettings& oscillators = settings.oscillators;
+    
+    // === CALCULATE PER-VOICE PITCH, FILTER AND AMPLITUDE MODULATION ===
+    // Each voice's own velocity and aftertouch routes on top of the segment's channel controller
+    // modulation. They only change at events, so they are constant over the segment; the LFO
+    // part is added per sample (pitch, amp) and per sub-block (filter).
+    // Inactive voices keep a gain and noise gain of 0, which masks their lane out of the mix.
+    using M = Neon37ModulationMatrix;
+    alignas(32) LaneArray voicePitchOctaves{}, voiceFilterMod{}, voiceAmpMod{}, voiceGain{}, voiceNoiseGain{};
+    for (int v = 0; v < VOICE_LANES; ++v)
     {
-        // Handle note-offs for poly mode
-        for (int note : releasedNotes)
-        {
-            for (int i = 0; i < MAX_VOICES; ++i)
-            {
-                if (voices[i].active && voices[i].midiNote == note)
-                {
-                    voices[i].ampEnv.noteOff();
-                    break;
-                }
-            }
-        }
+        const Neon37Voice& voice = groupVoices[v];
+        if (!voice.active)
+            continue;
+        
+        M::SourceValues noteValues{};
+        noteValues[M::velocity] = voice.velocity;
+        noteValues[M::aftertouch] = voice.aftertouch;
+        M::DestinationValues noteMod{};
+        derived.modMatrix.accumulate(noteValues, M::noteSources, noteMod);
         
-        // Render each active voice with complete per-voice signal chain
-        for (int voiceIdx = 0; voiceIdx < MAX_VOICES; ++voiceIdx)
+        voicePitchOctaves[(size_t)v] = noteMod[M::pitch] / 12.0f;
+        voiceFilterMod[(size_t)v] = settings.filterMod + noteMod[M::cutoff];
+        voiceAmpMod[(size_t)v] = settings.ampMod + noteMod[M::amp];
+        voiceGain[(size_t)v] = 1.0f;
+        voiceNoiseGain[(size_t)v] = settings.mixerNoise;
+    }
+    
+    // Render all of the group's lanes together in control-rate sub-blocks, retuning each voice's filter once per sub-block
+    for (int subStart = startSample; subStart < endSample; subStart += controlBlockSize)
+    {
+        const int subEnd = juce::jmin(endSample, subStart + controlBlockSize);
+        
+        // An envelope whose lanes are all idle or sustaining holds still for the whole sub-block
+        // (notes only start or end between segments): read its values once instead of stepping it
+        const bool pitchEnvSteady = lanes.pitchEnv.isSteady();
+        const bool filterEnvSteady = lanes.filterEnv.isSteady();
+        const bool ampEnvSteady = lanes.ampEnv.isSteady();
+        if (pitchEnvSteady)
+            lanes.pitchEnv.process(pitchEnvValues.data(), 1);
+        if (filterEnvSteady)
+            lanes.filterEnv.process(filterEnvValues.data(), 1);
+        
+        // Oscillators (+ noise) into each voice's lane, stepping the pitch and filter envelopes
+        for (int sample = subStart; sample < subEnd; ++sample)
         {
-            if (!voices[voiceIdx].active)
-                continue;
+            float* frame = voiceFrames + sample * VOICE_LANES;
+            const float lfoPitch = settings.lfoPitchOctaves[sample];
+            lanes.advanceGlide();
+            if (!pitchEnvSteady)
+                lanes.pitchEnv.process(pitchEnvValues.data());
+            if (!filterEnvSteady)
+                lanes.filterEnv.process(filterEnvValues.data());
             
-            // Render voice's oscillators
-            voices[voiceIdx].voiceBuffer.clear();
-            
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            if (derived.unisonCount > 1)
             {
-                // Sample-accurate pitch for this voice
-                const float voiceBaseFreq = voices[voiceIdx].pitchGlide.getNextValue();
-
-                // Apply all pitch modulations (LFO, velocity, aftertouch, pitch bend)
-                const float voiceLfoModFreq = voiceBaseFreq * totalPitchModRatio;
-
-                const float voiceOsc1FreqBase = voiceLfoModFreq * osc1Ratio;
-                const float voiceOsc2FreqBase = voiceLfoModFreq * osc2Ratio;
-
-                // Pitch Envelope
-                float pitchEnvValue = voices[voiceIdx].pitchEnv.getNextSample();
-                float pitchEgMod = pitchEnvValue * pitchEgDepth; // Semitones
-                float osc1PitchMod = (pitchEgTarget == 0 || pitchEgTarget == 1) ? pitchEgMod : 0.0f;
-                float osc2PitchMod = (pitchEgTarget == 2 || pitchEgTarget == 1) ? pitchEgMod : 0.0f;
-
-                // Calculate current sample frequency with Pitch EG
-                float currentVoiceOsc1Freq = voiceOsc1FreqBase * std::pow(2.0f, osc1PitchMod / 12.0f);
-                float currentVoiceOsc2Freq = voiceOsc2FreqBase * std::pow(2.0f, osc2PitchMod / 12.0f);
-                float currentVoiceSubFreq = currentVoiceOsc1Freq * 0.5f;
-
-                // Generate oscillator samples for this voice
-                float osc1Sample = generateWaveform(voices[voiceIdx].osc1Phase, osc1Wave) * mixerOsc1;
-                float osc2Sample = generateWaveform(voices[voiceIdx].osc2Phase, osc2Wave) * mixerOsc2;
-                float subSample = generateWaveform(voices[voiceIdx].subOscPhase, 2) * mixerSub1;
-                float noiseSample = (random.nextFloat() * 2.0f - 1.0f) * mixerNoise;
-                
-                float mixed = (osc1Sample + osc2Sample + subSample + noiseSample);
-                
-                for (int channel = 0; channel < totalNumOutputChannels; ++channel)
-                {
-                    voices[voiceIdx].voiceBuffer.setSample(channel, sample, mixed);
-                }
-                
-                // Update voice's oscillator phases
-                voices[voiceIdx].osc1Phase += twoPiOverSr * currentVoiceOsc1Freq;
-                voices[voiceIdx].osc2Phase += twoPiOverSr * currentVoiceOsc2Freq;
-                voices[voiceIdx].subOscPhase += twoPiOverSr * currentVoiceSubFreq;
-                
-                // Wrap phases
-                if (voices[voiceIdx].osc1Phase > juce::MathConstants<float>::twoPi) 
+                // Unison: each sounding voice renders its own stack of detuned copies
+                for (int v = 0; v < VOICE_LANES; ++v)
                 {
-                    voices[voiceIdx].osc1Phase -= juce::MathConstants<float>::twoPi;
-                    if (hardSync)
-                        voices[voiceIdx].osc2Phase = 0.0f;
+                    const float pitch = lanes.glideCurrent[(size_t)v] + voicePitchOctaves[(size_t)v] + lfoPitch;
+                    frame[v] = groupVoices[v].active
+                             ? renderUnisonSample(group.unison[(size_t)v],
+                                                  pitch + settings.osc1PitchOffset + pitchEnvValues[(size_t)v] * settings.osc1PitchEgOctaves,
+                                                  pitch + settings.osc2PitchOffset + pitchEnvValues[(size_t)v] * settings.osc2PitchEgOctaves,
+                                                  settings.oscillators)
+                             : 0.0f;
                 }
-                if (voices[voiceIdx].osc2Phase > juce::MathConstants<float>::twoPi) voices[voiceIdx].osc2Phase -= juce::MathConstants<float>::twoPi;
-                if (voices[voiceIdx].subOscPhase > juce::MathConstants<float>::twoPi) voices[voiceIdx].subOscPhase -= juce::MathConstants<float>::twoPi;
             }
-            
-            // Process this voice through its own filter with all modulations
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            else
             {
-                float filterEnvValue = voices[voiceIdx].filterEnv.getNextSample();
-                
-                // === CALCULATE PER-VOICE FILTER MODULATION ===
-                float velFilterAmount = *apvts.getRawParameterValue("vel_filter");
-                float atFilterAmount = *apvts.getRawParameterValue("at_filter");
+                // Sample-accurate pitch for every voice, with all pitch modulations and its own pitch envelope
+                for (int v = 0; v < VOICE_LANES; ++v)
+                {
+                    const float pitch = lanes.glideCurrent[(size_t)v] + voicePitchOctaves[(size_t)v] + lfoPitch;
+                    osc1Increment[(size_t)v] = Neon37FastMath::exp2(pitch + settings.osc1PitchOffset + pitchEnvValues[(size_t)v] * settings.osc1PitchEgOctaves);
+                    osc2Increment[(size_t)v] = Neon37FastMath::exp2(pitch + settings.osc2PitchOffset + pitchEnvValues[(size_t)v] * settings.osc2PitchEgOctaves);
+                    subIncrement[(size_t)v] = osc1Increment[(size_t)v] * 0.5f;
+                    osc1Step[(size_t)v] = Neon37Phase::fromCycles(osc1Increment[(size_t)v]);
+                    osc2Step[(size_t)v] = Neon37Phase::fromCycles(osc2Increment[(size_t)v]);
+                }
                 
-                // Calculate velocity and aftertouch modulation for this specific voice
-                float velFilterMod = velFilterAmount * voices[voiceIdx].velocity;
-                float atFilterMod = atFilterAmount * voices[voiceIdx].aftertouch;
+                lanes.getPhases(osc1Cycles.data(), osc2Cycles.data(), subCycles.data());
+                renderOscillatorLanes(oscillators.osc1Wave, oscillators.osc1Morph, osc1Cycles.data(), osc1Increment.data(), osc1Out.data());
+                renderOscillatorLanes(oscillators.osc2Wave, oscillators.osc2Morph, osc2Cycles.data(), osc2Increment.data(), osc2Out.data());
+                renderOscillatorLanes(Neon37PolyBLEP::square, 0.0f, subCycles.data(), subIncrement.data(), subOut.data());
                 
-                // Combine LFO + velocity + aftertouch for this voice's filter mod
-                float voiceTotalFilterMod = lfoFilterMod + velFilterMod + atFilterMod;
-                float voiceFilterModMultiplier = 1.0f + juce::jlimit(-5.0f, 5.0f, voiceTotalFilterMod);
+                for (int v = 0; v < VOICE_LANES; ++v)
+                    frame[v] = osc1Out[(size_t)v] * oscillators.mixerOsc1 + osc2Out[(size_t)v] * oscillators.mixerOsc2 + subOut[(size_t)v] * oscillators.mixerSub1;
                 
-                // Calculate and apply modulated cutoff
-                float modulatedCutoff = calculateModulatedCutoff(baseCutoff, filterEnvValue, egDepth, voiceFilterModMultiplier, resonance);
-                voices[voiceIdx].filter.setCutoffFrequencyHz(modulatedCutoff);
-                voices[voiceIdx].filter.setResonance(resonance);
-                voices[voiceIdx].filter.setDrive(drive);
+                lanes.advancePhases(osc1Step.data(), osc2Step.data(), oscillators.hardSync);
             }
             
-            // Apply per-voice filter
-            juce::dsp::AudioBlock<float> voiceBlock(voices[voiceIdx].voiceBuffer);
-            juce::dsp::ProcessContextReplacing<float> voiceContext(voiceBlock);
-            voices[voiceIdx].filter.process(voiceContext);
+            // Each voice draws from its own noise stream (gain 0 for inactive voices)
+            group.noise.next(noiseValues.data());
+            for (int v = 0; v < VOICE_LANES; ++v)
+                frame[v] += noiseValues[(size_t)v] * voiceNoiseGain[(size_t)v];
+        }
+        
+        // Retune each sounding voice's filter lane (cutoff from its envelope and the LFOs at the end
+        // of the sub-block), then filter all lanes together
+        const float lfoFilter = settings.lfoFilterMod[subEnd - 1];
+        for (int v = 0; v < VOICE_LANES; ++v)
+        {
+            if (!groupVoices[v].active)
+                continue;
             
-            // Apply per-voice amplitude envelope and mix to output (with all modulations)
-            // Generate all amp env samples first, then apply to all channels
-            juce::AudioBuffer<float> voiceAmpEnvBuffer(1, buffer.getNumSamples());
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-            {
-                float ampEnvValue = voices[voiceIdx].ampEnv.getNextSample();
-                
-                // === CALCULATE PER-VOICE AMPLITUDE MODULATION ===
-                float velAmpAmount = *apvts.getRawParameterValue("vel_amp");
-                float atAmpAmount = *apvts.getRawParameterValue("at_amp");
-                
-                // Calculate velocity and aftertouch modulation for this specific voice
-                float velAmpMod = velAmpAmount * voices[voiceIdx].velocity;
-                float atAmpMod = atAmpAmount * voices[voiceIdx].aftertouch;
-                
-                // Combine LFO + velocity + aftertouch for this voice's amp mod
-                float voiceTotalAmpMod = lfoAmpMod + velAmpMod + atAmpMod;
-                float voiceAmpModMultiplier = 1.0f + juce::jlimit(-5.0f, 5.0f, voiceTotalAmpMod);
-                
-                // Apply all amplitude modulations (LFO, velocity, aftertouch)
-                ampEnvValue *= voiceAmpModMultiplier;
-                voiceAmpEnvBuffer.setSample(0, sample, ampEnvValue);
-            }
+            const float filterModMultiplier = 1.0f + juce::jlimit(-5.0f, 5.0f, voiceFilterMod[(size_t)v] + lfoFilter);
+            float modulatedCutoff = calculateModulatedCutoff(settings.baseCutoff, filterEnvValues[(size_t)v], settings.egDepth, filterModMultiplier, settings.resonance);
+            group.filters.setCutoffFrequencyHz(v, modulatedCutoff);
+            group.filters.setResonance(v, settings.resonance);
+            group.filters.setDrive(v, settings.drive);
+        }
+        group.filters.process(voiceFrames + subStart * VOICE_LANES, subEnd - subStart);
+        
+        // Apply per-voice amplitude envelopes (with all modulations) and mix to output
+        if (ampEnvSteady)
+            lanes.ampEnv.process(ampEnvValues.data(), 1);
+        
+        for (int sample = subStart; sample < subEnd; ++sample)
+        {
+            if (!ampEnvSteady)
+                lanes.ampEnv.process(ampEnvValues.data());
             
-            // Mix to output with envelope scaling
-            for (int channel = 0; channel < totalNumOutputChannels; ++channel)
-            {
-                for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-                {
-                    float ampEnvValue = voiceAmpEnvBuffer.getSample(0, sample);
-                    float voiceSample = voices[voiceIdx].voiceBuffer.getSample(channel, sample);
-                    synthBuffer.addSample(channel, sample, voiceSample * ampEnvValue);
-                }
-            }
+            const float* frame = voiceFrames + sample * VOICE_LANES;
+            const float lfoAmp = settings.lfoAmpMod[sample];
+            float mixed = 0.0f;
+            for (int v = 0; v < VOICE_LANES; ++v)
+                mixed += frame[v] * ampEnvValues[(size_t)v] * voiceGain[(size_t)v] * (1.0f + juce::jlimit(-5.0f, 5.0f, voiceAmpMod[(size_t)v] + lfoAmp));
             
-            // Don't mark voice inactive until envelope is fully released
-            // Voice will continue rendering (silently) until ampEnv.isActive() returns false
-            if (!voices[voiceIdx].ampEnv.isActive())
-            {
-                voices[voiceIdx].active = false;
-            }
+            mix[sample] += mixed;
         }
     }
-    
-    // Process through shared filter (MONO and Paraphonic modes only)
-    if (voiceMode != 4)  // Not poly mode
+}
+
+void Neon37AudioProcessor::applyAmpModulation(float* ampEnvBuffer, int startSample, int numSamples, const ModulationState& modState) const
+{
+    for (int sample = startSample; sample < startSample + numSamples; ++sample)
+        ampEnvBuffer[sample] *= modState.ampModMultiplierAt(sample);
+}
+
+void Neon37AudioProcessor::cullMonoEnvelopes()
+{
+    // The shared amp envelope stops once it is below cull_floor and not rising (release, or a
+    // decay to a lower sustain): the rest of its tail is inaudible
+    if (monoAmpEnv.isBelow(derived.cullFloor))
+        monoAmpEnv.reset();
+    
+    // With the amp envelope idle the filter and pitch envelopes no longer reach the output;
+    // they restart from zero on the next note
+    if (!monoAmpEnv.isActive())
     {
-        juce::dsp::AudioBlock<float> block(synthBuffer);
-        juce::dsp::ProcessContextReplacing<float> context(block);
-        monoFilter.process(context);
+        monoFilterEnv.reset();
+        monoPitchEnv.reset();
     }
+}
+
+void Neon37AudioProcessor::processMonoFilterSubBlock(int startSample, int numSamples, float cutoffHz, float resonance, float drive)
+{
+    // One coefficient update per control-rate sub-block; the filter ramps cutoff and
+    // resonance linearly across the sub-block
+    monoFilter.setCutoffFrequencyHz(0, cutoffHz);
+    monoFilter.setResonance(0, resonance);
+    monoFilter.setDrive(0, drive);
+    
+    monoFilter.process(scratch.getMonoMix() + startSample, numSamples);
+}
+
+float Neon37AudioProcessor::generateWaveform(float phase, float phaseIncrement, int waveformType, float morph)
+{
+    // Wavetable engine: mip level picked from the increment, morph blends toward the next waveform
+    if (params.oscEngine == 1)
+        return wavetables->readMorph((float)waveformType + morph, phase, phaseIncrement);
     
-    // Apply master volume and amplitude envelope (for MONO/Paraphonic) or just master volume (for Poly), then output
-    for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+    // Bandlimited (polyBLEP/polyBLAMP) waveform; sine needs no correction
+    return Neon37PolyBLEP::render(waveformType, phase, phaseIncrement);
+}
+
+void Neon37AudioProcessor::renderOscillatorLanes(int waveformType, float morph, const float* phases, const float* increments, float* out)
+{
+    // Wavetable reads are per-lane lookups; the polyBLEP waveforms render all lanes in one vector loop
+    if (params.oscEngine == 1)
     {
-        buffer.copyFrom(channel, 0, synthBuffer, channel, 0, buffer.getNumSamples());
-        
-        if (voiceMode != 4)  // Not poly mode - apply shared amp envelope with all modulations
-        {
-            // Apply master volume and shared amplitude envelope per-sample
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-            {
-                float ampValue = ampEnvBuffer.getSample(0, sample);
-                // Apply all amplitude modulations (LFO, velocity, aftertouch)
-                ampValue *= totalAmpModMultiplier;
-                float sample_val = buffer.getSample(channel, sample);
-                buffer.setSample(channel, sample, sample_val * masterVol * ampValue);
-            }
-        }
-        else  // Poly mode - just apply master volume (per-voice envelopes already applied)
-        {
-            // Apply master volume only
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-            {
-                float sample_val = buffer.getSample(channel, sample);
-                buffer.setSample(channel, sample, sample_val * masterVol);
-            }
-        }
+        for (int v = 0; v < Neon37VoiceLanes::numLanes; ++v)
+            out[v] = wavetables->readMorph((float)waveformType + morph, phases[v], increments[v]);
+        return;
     }
+    
+    Neon37PolyBLEP::renderLanes<Neon37VoiceLanes::numLanes>(waveformType, phases, increments, out);
 }
 
-float Neon37AudioProcessor::generateWaveform(float phase, int waveformType)
+Neon37AudioProcessor::OscillatorSettings Neon37AudioProcessor::getOscillatorSettings() const
 {
-    // Normalize phase to 0-1
-    float normPhase = phase / juce::MathConstants<float>::twoPi;
-    normPhase = normPhase - std::floor(normPhase);
-    
-    float sample = 0.0f;
+    return { params.osc1Wave, params.osc2Wave, params.osc1Morph, params.osc2Morph,
+             derived.mixerOsc1, derived.mixerOsc2, derived.mixerSub1, params.hardSync };
+}
+
+float Neon37AudioProcessor::renderUnisonSample(Neon37UnisonStack& stack, float osc1Pitch, float osc2Pitch, const OscillatorSettings& oscillators)
+{
+    using LaneArray = Neon37UnisonStack::LaneArray;
+    alignas(32) LaneArray osc1Increment, osc2Increment, subIncrement, osc1Out, osc2Out, subOut;
+    alignas(32) LaneArray osc1Cycles, osc2Cycles, subCycles;
+    alignas(32) Neon37UnisonStack::PhaseArray osc1Step, osc2Step;
     
-    switch (waveformType)
+    // Every copy at its detune offset; unused copies are computed too and mixed at gain 0
+    for (int c = 0; c < Neon37UnisonStack::numLanes; ++c)
     {
-        case 0: // Sine (no aliasing)
-            sample = std::sin(phase);
-            break;
-            
-        case 1: // Triangle (bandlimited approximation)
-        {
-            // Better triangle with reduced aliasing
-            sample = 4.0f * std::abs(normPhase - 0.5f) - 1.0f;
-            // Apply light saturation to smooth edges
-            float saturated = std::tanh(sample * 1.2f) / 1.2f;
-            sample = saturated;
-            break;
-        }
-            
-        case 2: // Sawtooth (anti-aliased)
-        {
-            // Sawtooth with Gibbs correction for aliasing reduction
-            sample = 2.0f * normPhase - 1.0f;
-            // Apply anti-aliasing filter via saturation
-            sample = std::tanh(sample * 0.8f) / 0.8f;
-            break;
-        }
-            
-        case 3: // Square (anti-aliased via soft switching)
-        {
-            // Instead of hard square, use smooth transition
-            float transition = std::sin(normPhase * juce::MathConstants<float>::pi);
-            float hardSquare = normPhase < 0.5f ? 1.0f : -1.0f;
-            // Blend with smoothed version to reduce aliasing
-            sample = hardSquare * 0.85f + transition * 0.25f;
-            break;
-        }
-            
-        case 4: // 25% Pulse (anti-aliased)
-        {
-            float transition = std::sin(normPhase * juce::MathConstants<float>::pi);
-            float hardPulse = normPhase < 0.25f ? 1.0f : -1.0f;
-            sample = hardPulse * 0.85f + transition * 0.25f;
-            break;
-        }
-            
-        case 5: // 10% Pulse (anti-aliased)
-        {
-            float transition = std::sin(normPhase * juce::MathConstants<float>::pi);
-            float hardPulse = normPhase < 0.10f ? 1.0f : -1.0f;
-            sample = hardPulse * 0.85f + transition * 0.25f;
-            break;
-        }
-            
-        default:
-            sample = std::sin(phase);
-            break;
+        osc1Increment[(size_t)c] = Neon37FastMath::exp2(osc1Pitch + derived.unisonOctaves[(size_t)c]);
+        osc2Increment[(size_t)c] = Neon37FastMath::exp2(osc2Pitch + derived.unisonOctaves[(size_t)c]);
+        subIncrement[(size_t)c] = osc1Increment[(size_t)c] * 0.5f;
+        osc1Step[(size_t)c] = Neon37Phase::fromCycles(osc1Increment[(size_t)c]);
+        osc2Step[(size_t)c] = Neon37Phase::fromCycles(osc2Increment[(size_t)c]);
     }
     
-    return sample;
+    stack.getPhases(osc1Cycles.data(), osc2Cycles.data(), subCycles.data());
+    renderOscillatorLanes(oscillators.osc1Wave, oscillators.osc1Morph, osc1Cycles.data(), osc1Increment.data(), osc1Out.data());
+    renderOscillatorLanes(oscillators.osc2Wave, oscillators.osc2Morph, osc2Cycles.data(), osc2Increment.data(), osc2Out.data());
+    renderOscillatorLanes(Neon37PolyBLEP::square, 0.0f, subCycles.data(), subIncrement.data(), subOut.data());
+    
+    float mixed = 0.0f;
+    for (int c = 0; c < Neon37UnisonStack::numLanes; ++c)
+        mixed += derived.unisonGains[(size_t)c] * (osc1Out[(size_t)c] * oscillators.mixerOsc1 + osc2Out[(size_t)c] * oscillators.mixerOsc2 + subOut[(size_t)c] * oscillators.mixerSub1);
+    
+    stack.advancePhases(osc1Step.data(), osc2Step.data(), oscillators.hardSync);
+    return mixed;
 }
 
 bool Neon37AudioProcessor::hasEditor() const
@@ -1470,120 +1663,147 @@ void Neon37AudioProcessor::resetToDefaults()
 
 juce::AudioProcessorValueTreeState::ParameterLayout Neon37AudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> layoutParams;
 
     // Master Section
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("master_volume", "Volume", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("master_tune", "Master Tune", juce::NormalisableRange<float> (400.0f, 480.0f, 0.1f, 1.0f), 440.0f)); // A4 center
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("master_volume", "Volume", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("master_tune", "Master Tune", juce::NormalisableRange<float> (400.0f, 480.0f, 0.1f, 1.0f), 440.0f)); // A4 center
 
     // Oscillator 1
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("osc1_wave", "Osc 1 Wave", juce::StringArray { "Sine", "Triangle", "Sawtooth", "Square", "25% Pulse", "10% Pulse" }, 2)); // Default: Sawtooth
-    params.push_back (std::make_unique<juce::AudioParameterInt> ("osc1_octave", "Osc 1 Octave", -3, 3, 0));
-    params.push_back (std::make_unique<juce::AudioParameterInt> ("osc1_semitones", "Osc 1 Semitones", -12, 12, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("osc1_fine", "Osc 1 Fine", juce::NormalisableRange<float> (-0.5f, 0.5f, 0.01f, 1.0f), 0.0f)); // ±50 cents
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("osc1_wave", "Osc 1 Wave", juce::StringArray { "Sine", "Triangle", "Sawtooth", "Square", "25% Pulse", "10% Pulse" }, 2)); // Default: Sawtooth
+    layoutParams.push_back (std::make_unique<juce::AudioParameterInt> ("osc1_octave", "Osc 1 Octave", -3, 3, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterInt> ("osc1_semitones", "Osc 1 Semitones", -12, 12, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("osc1_fine", "Osc 1 Fine", juce::NormalisableRange<float> (-0.5f, 0.5f, 0.01f, 1.0f), 0.0f)); // ±50 cents
     
     // Oscillator 2
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("osc2_wave", "Osc 2 Wave", juce::StringArray { "Sine", "Triangle", "Sawtooth", "Square", "25% Pulse", "10% Pulse" }, 2)); // Default: Sawtooth
-    params.push_back (std::make_unique<juce::AudioParameterInt> ("osc2_octave", "Osc 2 Octave", -3, 3, 0));
-    params.push_back (std::make_unique<juce::AudioParameterInt> ("osc2_semitones", "Osc 2 Semitones", -12, 12, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("osc2_fine", "Osc 2 Fine", juce::NormalisableRange<float> (-0.5f, 0.5f, 0.01f, 1.0f), 0.0f)); // ±50 cents
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("osc2_wave", "Osc 2 Wave", juce::StringArray { "Sine", "Triangle", "Sawtooth", "Square", "25% Pulse", "10% Pulse" }, 2)); // Default: Sawtooth
+    layoutParams.push_back (std::make_unique<juce::AudioParameterInt> ("osc2_octave", "Osc 2 Octave", -3, 3, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterInt> ("osc2_semitones", "Osc 2 Semitones", -12, 12, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("osc2_fine", "Osc 2 Fine", juce::NormalisableRange<float> (-0.5f, 0.5f, 0.01f, 1.0f), 0.0f)); // ±50 cents
 
     // Global Osc
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("osc_freq", "Osc Frequency", -7.0f, 7.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("osc_beat", "Beat Rate", -3.5f, 3.5f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("hard_sync", "Hard Sync", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("osc_freq", "Osc Frequency", -7.0f, 7.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("osc_beat", "Beat Rate", -3.5f, 3.5f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("hard_sync", "Hard Sync", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("osc_engine", "Osc Engine", juce::StringArray { "PolyBLEP", "Wavetable" }, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("osc1_morph", "Osc 1 Morph", 0.0f, 1.0f, 0.0f)); // Wavetable: blend toward the next waveform
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("osc2_morph", "Osc 2 Morph", 0.0f, 1.0f, 0.0f));
 
     // Mixer
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_osc1", "Mixer Osc 1", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_sub1", "Mixer Sub 1", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), -60.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_osc2", "Mixer Osc 2", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), -60.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_noise", "Mixer Noise", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), -60.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_return", "Mixer Return", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), -60.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_osc1", "Mixer Osc 1", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_sub1", "Mixer Sub 1", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), -60.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_osc2", "Mixer Osc 2", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), -60.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_noise", "Mixer Noise", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), -60.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("mixer_return", "Mixer Return", juce::NormalisableRange<float> (-60.0f, 10.0f, 0.1f, 2.0f), -60.0f));
 
     // Filter
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("cutoff", "Cutoff", juce::NormalisableRange<float> (20.0f, 20000.0f, 1.0f, 0.3f), 20000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("resonance", "Resonance", 0.0f, 1.2f, 0.0f)); // Up to 1.2 for self-oscillation
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive", 1.0f, 25.0f, 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("eg_depth", "EG Depth", juce::NormalisableRange<float> (-100.0f, 100.0f, 1.0f, 1.0f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("key_track", "Key Track", 0.0f, 2.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("cutoff", "Cutoff", juce::NormalisableRange<float> (20.0f, 20000.0f, 1.0f, 0.3f), 20000.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("resonance", "Resonance", 0.0f, 1.2f, 0.0f)); // Up to 1.2 for self-oscillation
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive", 1.0f, 25.0f, 1.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("eg_depth", "EG Depth", juce::NormalisableRange<float> (-100.0f, 100.0f, 1.0f, 1.0f), 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("key_track", "Key Track", 0.0f, 2.0f, 0.0f));
 
     // Envelope 1 (Filter/Mod) - Exponential time range 3ms to 10s
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env1_attack", "Env 1 Attack", juce::NormalisableRange<float> (0.001f, 10.0f, 0.001f, 0.2f), 0.001f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env1_decay", "Env 1 Decay", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env1_sustain", "Env 1 Sustain", 0.0f, 1.0f, 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env1_release", "Env 1 Release", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env1_attack", "Env 1 Attack", juce::NormalisableRange<float> (0.001f, 10.0f, 0.001f, 0.2f), 0.001f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env1_decay", "Env 1 Decay", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env1_sustain", "Env 1 Sustain", 0.0f, 1.0f, 1.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env1_release", "Env 1 Release", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
 
     // Envelope 2 (Amplitude) - Exponential time range 3ms to 10s
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env2_attack", "Env 2 Attack", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.003f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env2_decay", "Env 2 Decay", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env2_sustain", "Env 2 Sustain", 0.0f, 1.0f, 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env2_release", "Env 2 Release", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("env_exp_curv", "Exponential Envelopes", true));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env2_attack", "Env 2 Attack", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.003f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env2_decay", "Env 2 Decay", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env2_sustain", "Env 2 Sustain", 0.0f, 1.0f, 1.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env2_release", "Env 2 Release", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("env_exp_curv", "Exponential Envelopes", true));
 
     // Pitch Envelope
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_attack", "Pitch Env Attack", juce::NormalisableRange<float> (0.001f, 10.0f, 0.001f, 0.2f), 0.001f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_decay", "Pitch Env Decay", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_sustain", "Pitch Env Sustain", 0.0f, 1.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_release", "Pitch Env Release", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_depth", "Pitch Env Depth", juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f, 1.0f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("env_pitch_target", "Pitch Env Target", juce::StringArray { "Osc 1", "Both", "Osc 2" }, 1)); // Match UI: 0=Osc1, 1=Both, 2=Osc2
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_attack", "Pitch Env Attack", juce::NormalisableRange<float> (0.001f, 10.0f, 0.001f, 0.2f), 0.001f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_decay", "Pitch Env Decay", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_sustain", "Pitch Env Sustain", 0.0f, 1.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_release", "Pitch Env Release", juce::NormalisableRange<float> (0.003f, 10.0f, 0.001f, 0.2f), 0.05f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("env_pitch_depth", "Pitch Env Depth", juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f, 1.0f), 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("env_pitch_target", "Pitch Env Target", juce::StringArray { "Osc 1", "Both", "Osc 2" }, 1)); // Match UI: 0=Osc1, 1=Both, 2=Osc2
 
     // Arpeggiator
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("arp_on", "Arp On", false)); // Default OFF
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("voice_mode", "Voice Mode", juce::StringArray { "Mono-L", "Mono", "Para-L", "Para", "Poly" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("hold_mode", "Hold Mode", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("arp_on", "Arp On", false)); // Default OFF
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("voice_mode", "Voice Mode", juce::StringArray { "Mono-L", "Mono", "Para-L", "Para", "Poly" }, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("hold_mode", "Hold Mode", false));
     
     // Glide/Portamento - defaults to OFF (time = 0)
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("glide_time", "Glide", juce::NormalisableRange<float> (0.0f, 1000.0f, 1.0f, 4.0f), 0.0f)); // 0-1000ms, exponential with low-end granularity
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("glide_rate", "Glide Rate", true)); // Default: Rate mode ON
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("glide_legato", "Glide Legato", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("glide_time", "Glide", juce::NormalisableRange<float> (0.0f, 1000.0f, 1.0f, 4.0f), 0.0f)); // 0-1000ms, exponential with low-end granularity
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("glide_rate", "Glide Rate", true)); // Default: Rate mode ON
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("glide_legato", "Glide Legato", false));
 
     // LFO 1
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo1_rate", "LFO 1 Rate", juce::NormalisableRange<float> (0.01f, 100.0f, 0.01f, 0.3f), 0.1f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("lfo1_sync", "LFO 1 Sync", false));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("lfo1_sync_val", "LFO 1 Sync Val", juce::StringArray { "1/64", "1/32", "1/16", "1/8", "1/4", "1/2", "1/1", "2/1", "3/1", "4/1", "8/1" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("lfo1_key_reset", "LFO 1 Key Reset", false));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("lfo1_wave", "LFO 1 Wave", juce::StringArray { "Triangle", "Ramp Up", "Ramp Down", "Square", "S&H" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo1_pitch", "LFO 1 Pitch", 0.0f, 1.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo1_filter", "LFO 1 Filter", 0.0f, 1.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo1_amp", "LFO 1 Amp", 0.0f, 1.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo1_rate", "LFO 1 Rate", juce::NormalisableRange<float> (0.01f, 100.0f, 0.01f, 0.3f), 0.1f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("lfo1_sync", "LFO 1 Sync", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("lfo1_sync_val", "LFO 1 Sync Val", juce::StringArray { "1/64", "1/32", "1/16", "1/8", "1/4", "1/2", "1/1", "2/1", "3/1", "4/1", "8/1" }, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("lfo1_key_reset", "LFO 1 Key Reset", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("lfo1_wave", "LFO 1 Wave", juce::StringArray { "Triangle", "Ramp Up", "Ramp Down", "Square", "S&H" }, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo1_pitch", "LFO 1 Pitch", 0.0f, 1.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo1_filter", "LFO 1 Filter", 0.0f, 1.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo1_amp", "LFO 1 Amp", 0.0f, 1.0f, 0.0f));
 
     // LFO 2
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo2_rate", "LFO 2 Rate", juce::NormalisableRange<float> (0.01f, 100.0f, 0.01f, 0.3f), 0.1f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("lfo2_sync", "LFO 2 Sync", false));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("lfo2_sync_val", "LFO 2 Sync Val", juce::StringArray { "1/64", "1/32", "1/16", "1/8", "1/4", "1/2", "1/1", "2/1", "3/1", "4/1", "8/1" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("lfo2_key_reset", "LFO 2 Key Reset", false));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("lfo2_wave", "LFO 2 Wave", juce::StringArray { "Triangle", "Ramp Up", "Ramp Down", "Square", "S&H" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo2_pitch", "LFO 2 Pitch", 0.0f, 1.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo2_filter", "LFO 2 Filter", 0.0f, 1.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo2_amp", "LFO 2 Amp", 0.0f, 1.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo2_rate", "LFO 2 Rate", juce::NormalisableRange<float> (0.01f, 100.0f, 0.01f, 0.3f), 0.1f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("lfo2_sync", "LFO 2 Sync", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("lfo2_sync_val", "LFO 2 Sync Val", juce::StringArray { "1/64", "1/32", "1/16", "1/8", "1/4", "1/2", "1/1", "2/1", "3/1", "4/1", "8/1" }, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("lfo2_key_reset", "LFO 2 Key Reset", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("lfo2_wave", "LFO 2 Wave", juce::StringArray { "Triangle", "Ramp Up", "Ramp Down", "Square", "S&H" }, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo2_pitch", "LFO 2 Pitch", 0.0f, 1.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo2_filter", "LFO 2 Filter", 0.0f, 1.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("lfo2_amp", "LFO 2 Amp", 0.0f, 1.0f, 0.0f));
 
     // Velocity - Pitch: -12 to +12 semitones (snap), Filter and Amp: -200% to +500% (continuous)
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("vel_pitch", "Vel Pitch", juce::NormalisableRange<float>(-12.0f, 12.0f, 1.0f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("vel_filter", "Vel Filter", -5.0f, 5.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("vel_amp", "Vel Amp", -2.0f, 2.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("vel_pitch", "Vel Pitch", juce::NormalisableRange<float>(-12.0f, 12.0f, 1.0f), 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("vel_filter", "Vel Filter", -5.0f, 5.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("vel_amp", "Vel Amp", -2.0f, 2.0f, 0.0f));
 
     // Aftertouch - Pitch: -12 to +12 semitones (snap), Filter and Amp: -200% to +500% (continuous)
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("at_pitch", "AT Pitch", juce::NormalisableRange<float>(-12.0f, 12.0f, 1.0f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("at_filter", "AT Filter", -5.0f, 5.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("at_amp", "AT Amp", -2.0f, 2.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("at_pitch", "AT Pitch", juce::NormalisableRange<float>(-12.0f, 12.0f, 1.0f), 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("at_filter", "AT Filter", -5.0f, 5.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("at_amp", "AT Amp", -2.0f, 2.0f, 0.0f));
 
     // Pitch Bend - Pitch: 1-12 semitones (snap), Filter and Amp: -200% to +500% (continuous)
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pb_pitch", "PB Pitch", juce::NormalisableRange<float>(1.0f, 12.0f, 1.0f), 2.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pb_filter", "PB Filter", -5.0f, 5.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pb_amp", "PB Amp", -2.0f, 2.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("pb_pitch", "PB Pitch", juce::NormalisableRange<float>(1.0f, 12.0f, 1.0f), 2.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("pb_filter", "PB Filter", -5.0f, 5.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("pb_amp", "PB Amp", -2.0f, 2.0f, 0.0f));
 
     // Mod Wheel - Pitch: -12 to +12 semitones (snap), Filter and Amp: -200% to +500% (continuous)
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mw_pitch", "MW Pitch", juce::NormalisableRange<float>(-12.0f, 12.0f, 1.0f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mw_filter", "MW Filter", -5.0f, 5.0f, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mw_amp", "MW Amp", -2.0f, 2.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("mw_pitch", "MW Pitch", juce::NormalisableRange<float>(-12.0f, 12.0f, 1.0f), 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("mw_filter", "MW Filter", -5.0f, 5.0f, 0.0f));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("mw_amp", "MW Amp", -2.0f, 2.0f, 0.0f));
 
     // Mod Wheel Toggles - removed vel_mw, at_mw, pb_mw
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("mw_enable", "MW Enable", false));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("lfo1_mw", "LFO 1 MW", false));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("lfo2_mw", "LFO 2 MW", false));
-
-    return { params.begin(), params.end() };
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("mw_enable", "MW Enable", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("lfo1_mw", "LFO 1 MW", false));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterBool> ("lfo2_mw", "LFO 2 MW", false));
+
+    // Render quality - HQ runs oscillators, drive and filter oversampled (adds latency)
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("hq_mode", "HQ Mode", juce::StringArray { "Off", "2x", "4x", "8x" }, 0));
+
+    // Polyphony (Para/Poly) - a patch setting, not automatable; the voice pool is preallocated for the maximum
+    layoutParams.push_back (std::make_unique<juce::AudioParameterInt> ("voice_count", "Voices", 1, neon37MaxVoices, 8,
+                                                                 juce::AudioParameterIntAttributes().withAutomatable (false)));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("voice_steal", "Voice Steal", juce::StringArray { "Oldest", "Quietest", "Releasing First" }, 0));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("cull_floor", "Cull Floor", juce::NormalisableRange<float> (-120.0f, -60.0f, 1.0f), -96.0f,
+                                                                   juce::AudioParameterFloatAttributes().withAutomatable (false).withLabel ("dB")));
+
+    // Poly rendering threads - a host/machine setting, not automatable; workers start when the engine is prepared
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("poly_threads", "Poly Threads", juce::StringArray { "Off", "2", "4", "8" }, 0,
+                                                                    juce::AudioParameterChoiceAttributes().withAutomatable (false)));
+
+    // Render-ahead chunk size - also a host/machine setting; adds two chunks of latency
+    layoutParams.push_back (std::make_unique<juce::AudioParameterChoice> ("render_ahead", "Render Ahead", juce::StringArray { "Off", "256", "512", "1024" }, 0,
+                                                                    juce::AudioParameterChoiceAttributes().withAutomatable (false)));
+
+    // Unison - detuned copies of the oscillator set per voice, mixed before the voice's filter
+    layoutParams.push_back (std::make_unique<juce::AudioParameterInt> ("unison_voices", "Unison Voices", 1, Neon37DerivedParameters::maxUnison, 1));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("unison_detune", "Unison Detune", juce::NormalisableRange<float> (0.0f, 100.0f, 0.1f, 0.5f), 20.0f,
+                                                                   juce::AudioParameterFloatAttributes().withLabel ("cents")));
+    layoutParams.push_back (std::make_unique<juce::AudioParameterFloat> ("unison_spread", "Unison Spread", 0.0f, 1.0f, 1.0f)); // Start phase spread of the copies
+
+    return { layoutParams.begin(), layoutParams.end() };
 }
 
 float Neon37AudioProcessor::getSyncMultiplier(int syncIndex)
@@ -1597,100 +1817,53 @@ float Neon37AudioProcessor::getSyncMultiplier(int syncIndex)
     return multipliers[syncIndex];
 }
 
-float Neon37AudioProcessor::generateLFOWaveform(float phase, int waveformType)
+// === REFACTORED HELPERS FOR CLEANER CODE ===
+
+Neon37ModulationMatrix::SourceValues Neon37AudioProcessor::getControlSourceValues() const
 {
-    // Normalize phase to 0-1
-    float normPhase = phase / juce::MathConstants<float>::twoPi;
-    normPhase = normPhase - std::floor(normPhase);
-    
-    switch (waveformType)
-    {
-        case 0: // Triangle
-            return 4.0f * std::abs(normPhase - 0.5f) - 1.0f;
-            
-        case 1: // Ramp Up (Sawtooth)
-            return 2.0f * normPhase - 1.0f;
-            
-        case 2: // Ramp Down
-            return 1.0f - 2.0f * normPhase;
-            
-        case 3: // Square
-            return normPhase < 0.5f ? 1.0f : -1.0f;
-            
-        case 4: // Sample & Hold
-        {
-            // Simple S&H: quantize to 32 steps per cycle
-            int step = (int)(normPhase * 32.0f);
-            // Generate deterministic pseudo-random value per step
-            uint32_t seed = step * 2654435761U;
-            seed = seed ^ (seed >> 16);
-            seed = seed * 73856093U;
-            return ((float)(seed & 0x7FFF) / 32767.5f) - 1.0f;
-        }
-        
-        default:
-            return 0.0f;
-    }
+    // LFOs and envelopes are applied per sample and stay 0 here
+    Neon37ModulationMatrix::SourceValues values{};
+    values[Neon37ModulationMatrix::velocity] = currentVelocity;
+    values[Neon37ModulationMatrix::aftertouch] = currentAftertouch;
+    values[Neon37ModulationMatrix::modWheel] = modWheelValueRaw;
+    values[Neon37ModulationMatrix::pitchBend] = pitchBendValue;
+    return values;
 }
 
-// === REFACTORED HELPERS FOR CLEANER CODE ===
+void Neon37AudioProcessor::calculateAllModulations(ModulationState& modState, int voiceMode)
+{
+    // Walk the compiled routes from the controller sources (velocity, aftertouch, mod wheel,
+    // bend). Poly voices add their own velocity and aftertouch routes per voice, so only the
+    // channel controllers are summed here; the LFO part is added per sample (renderLFOs).
+    using M = Neon37ModulationMatrix;
+    const M::SourceMask sources = voiceMode == 4 ? M::channelSources : (M::channelSources | M::noteSources);
+    
+    M::DestinationValues totals{};
+    derived.modMatrix.accumulate(getControlSourceValues(), sources, totals);
+    
+    modState.pitchModSemitones = totals[M::pitch];
+    modState.filterMod = totals[M::cutoff];
+    modState.ampMod = totals[M::amp];
+}
 
-void Neon37AudioProcessor::calculateAllModulations(ModulationState& modState, float lfoFilterMod, float lfoPitchMod, float lfoAmpMod, float modWheelScale)
+float Neon37AudioProcessor::getGlideSeconds(float sourcePitch, float targetPitch) const
 {
-    // Convert LFO pitch modulation to semitones
-    float pitchModSemitones = lfoPitchMod * 12.0f * modWheelScale;
-    
-    // === VELOCITY MODULATION ===
-    float velPitchAmount = *apvts.getRawParameterValue("vel_pitch");
-    float velFilterAmount = *apvts.getRawParameterValue("vel_filter");
-    float velAmpAmount = *apvts.getRawParameterValue("vel_amp");
-    
-    float velPitchMod = velPitchAmount * currentVelocity;
-    float velFilterMod = velFilterAmount * currentVelocity;
-    float velAmpMod = velAmpAmount * currentVelocity;
-    
-    // === AFTERTOUCH MODULATION ===
-    float atPitchAmount = *apvts.getRawParameterValue("at_pitch");
-    float atFilterAmount = *apvts.getRawParameterValue("at_filter");
-    float atAmpAmount = *apvts.getRawParameterValue("at_amp");
+    const float glideSeconds = params.glideTimeMs / 1000.0f;
     
-    float atPitchMod = atPitchAmount * currentAftertouch;
-    float atFilterMod = atFilterAmount * currentAftertouch;
-    float atAmpMod = atAmpAmount * currentAftertouch;
+    // Time mode: constant time regardless of interval
+    if (!params.glideRate)
+        return glideSeconds;
     
-    // === MOD WHEEL MODULATION ===
-    float mwPitchAmount = *apvts.getRawParameterValue("mw_pitch");
-    float mwFilterAmount = *apvts.getRawParameterValue("mw_filter");
-    float mwAmpAmount = *apvts.getRawParameterValue("mw_amp");
-    
-    float mwPitchMod = mwPitchAmount * modWheelValueRaw;
-    float mwFilterMod = mwFilterAmount * modWheelValueRaw;
-    float mwAmpMod = mwAmpAmount * modWheelValueRaw;
-    
-    // === PITCH BEND MODULATION ===
-    float pbPitchAmount = *apvts.getRawParameterValue("pb_pitch");
-    float pbFilterAmount = *apvts.getRawParameterValue("pb_filter");
-    float pbAmpAmount = *apvts.getRawParameterValue("pb_amp");
-    
-    float pbPitchMod = pbPitchAmount * pitchBendValue;
-    float pbFilterMod = pbFilterAmount * pitchBendValue;
-    float pbAmpMod = pbAmpAmount * pitchBendValue;
-    
-    // === COMBINE ALL MODULATIONS ===
-    modState.pitchModSemitones = pitchModSemitones + velPitchMod + atPitchMod + mwPitchMod + pbPitchMod;
-    
-    float totalFilterMod = (lfoFilterMod * modWheelScale) + velFilterMod + atFilterMod + mwFilterMod + pbFilterMod;
-    modState.totalFilterModMultiplier = 1.0f + juce::jlimit(-5.0f, 5.0f, totalFilterMod);
-    
-    float totalAmpMod = (lfoAmpMod * modWheelScale) + velAmpMod + atAmpMod + mwAmpMod + pbAmpMod;
-    modState.totalAmpModMultiplier = 1.0f + juce::jlimit(-1.0f, 1.0f, totalAmpMod);
+    // Rate mode: constant semitones/sec implemented via time proportional to interval.
+    // Interpret glideTimeMs as "time for 1 octave" (pitches are log2 Hz, so the difference is in octaves).
+    return juce::jlimit(0.001f, 5.0f, glideSeconds * std::abs(targetPitch - sourcePitch));
 }
 
 float Neon37AudioProcessor::calculateModulatedCutoff(float baseCutoff, float filterEnvValue, float egDepth, float totalFilterModMultiplier, float /*resonance*/) const
 {
     // Apply envelope modulation to cutoff
     float egModulation = (egDepth / 100.0f) * filterEnvValue * 10.0f;
-    float modulatedCutoff = baseCutoff * std::pow(2.0f, egModulation);
+    float modulatedCutoff = baseCutoff * Neon37FastMath::exp2(egModulation);
     
     // Apply all filter modulations (LFO, velocity, aftertouch)
     modulatedCutoff *= totalFilterModMultiplier;
@@ -1699,35 +1872,61 @@ float Neon37AudioProcessor::calculateModulatedCutoff(float baseCutoff, float fil
     return modulatedCutoff;
 }
 
-int Neon37AudioProcessor::allocateVoice()
+int Neon37AudioProcessor::allocateVoice(int midiNote, int voiceMode)
 {
-    // Find an inactive voice or steal the oldest active one
-    int voiceToAllocate = -1;
-    for (int i = 0; i < MAX_VOICES; ++i)
+    // A free voice if there is one, otherwise one stolen by the voice_steal policy.
+    // Quietest compares the amp envelope in Poly; Para voices share one envelope, so only the gate differs.
+    const auto policy = (Neon37VoiceAllocator<MAX_VOICES>::StealPolicy) juce::jlimit(0, 2, params.voiceSteal);
+    auto levelOf = [this, voiceMode](int v)
     {
-        if (!voices[i].active)
-        {
-            voiceToAllocate = i;
-            break;
-        }
-    }
+        const auto& lanes = groupOf(v).lanes;
+        return voiceMode == 4 ? lanes.ampEnv.value[(size_t)laneOf(v)] : lanes.gate[(size_t)laneOf(v)];
+    };
+    
+    bool wasStolen = false;
+    const int voiceToAllocate = voiceAllocator.allocate(midiNote, policy, levelOf, wasStolen);
     
-    // If no inactive voice, steal the oldest one
-    if (voiceToAllocate == -1)
+    voices[(size_t)voiceToAllocate].midiNote = midiNote;
+    voices[(size_t)voiceToAllocate].active = true;
+    groupOf(voiceToAllocate).unison[(size_t)laneOf(voiceToAllocate)].spreadPhases(derived.unisonCount, params.unisonSpread);
+    return voiceToAllocate;
+}
+
+void Neon37AudioProcessor::freeVoice(int voice)
+{
+    voices[(size_t)voice].active = false;
+    voiceAllocator.free(voice);
+}
+
+bool Neon37AudioProcessor::isGroupActive(int group) const
+{
+    for (int v = group * VOICE_LANES; v < (group + 1) * VOICE_LANES; ++v)
     {
-        uint64_t oldestTimestamp = voices[0].allocationTimestamp;
-        voiceToAllocate = 0;
-        for (int i = 1; i < MAX_VOICES; ++i)
-        {
-            if (voices[i].allocationTimestamp < oldestTimestamp)
-            {
-                oldestTimestamp = voices[i].allocationTimestamp;
-                voiceToAllocate = i;
-            }
-        }
+        if (voices[v].active)
+            return true;
     }
+    return false;
+}
+
+void Neon37AudioProcessor::setVoiceCount(int newVoiceCount)
+{
+    voiceCount = juce::jlimit(1, MAX_VOICES, newVoiceCount);
+    voiceAllocator.setVoiceCount(voiceCount);
     
-    return voiceToAllocate;
+    // Voices beyond the new count are released (their tails still finish); the allocator keeps
+    // them draining, so they are not reallocated until freeVoice() runs when their envelope ends
+    for (int v = voiceCount; v < MAX_VOICES; ++v)
+    {
+        if (!voices[v].active)
+            continue;
+        
+        auto& lanes = groupOf(v).lanes;
+        const int lane = laneOf(v);
+        lanes.gate[(size_t)lane] = 0.0f;
+        lanes.filterEnv.noteOff(lane);
+        lanes.ampEnv.noteOff(lane);
+        lanes.pitchEnv.noteOff(lane);
+    }
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
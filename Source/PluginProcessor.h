@@ -2,56 +2,111 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "ParameterSnapshot.h"
+#include "WavetableBank.h"
+#include "FastMath.h"
+#include "VoiceLanes.h"
+#include "LadderFilter.h"
+#include "NoiseGenerator.h"
+#include "LFO.h"
+#include "VoiceAllocator.h"
+#include "Decimator.h"
+#include "WorkerPool.h"
+#include "RenderAhead.h"
 #include <map>
 #include <algorithm>
 #include <array>
 
-// LFO structure for global LFO modulation
-struct Neon37LFO
-{
-    float phase = 0.0f;           // 0-1 normalized phase
-    float rate = 0.1f;            // Hz (free mode) or tempo multiplier (sync mode)
-    int waveform = 0;             // 0=Triangle, 1=RampUp, 2=RampDown, 3=Square, 4=SampleHold
-    bool syncEnabled = false;
-    float pitchAmount = 0.0f;     // 0-12 semitones
-    float filterAmount = 0.0f;    // 0-1 (0-100%)
-    float ampAmount = 0.0f;       // 0-1 (0-100%)
-};
+// Control-rate sub-block size in samples: filter coefficients are updated once per sub-block
+// (set from CMake via NEON37_CONTROL_BLOCK_SIZE, e.g. 16 or 32)
+#ifndef NEON37_CONTROL_BLOCK_SIZE
+ #define NEON37_CONTROL_BLOCK_SIZE 32
+#endif
 
 // Voice structure for paraphonic and poly operation
-// Paraphonic: Uses shared monoFilter/monoFilterEnv/monoAmpEnv, per-voice oscillators + ampGate
+// Paraphonic: Uses shared monoFilter/monoFilterEnv/monoAmpEnv, per-voice oscillators + gate
 // Poly: Each voice has independent filter, filterEnv, ampEnv - complete signal chain per voice
+// The per-sample state (phases, glide, gate, envelopes, filter) lives in lane arrays (Neon37VoiceGroup)
 struct Neon37Voice
 {
     int midiNote = -1;
     bool active = false;
-    uint64_t allocationTimestamp = 0;  // Track when this voice was allocated (for stealing oldest voice)
-    
-    // Oscillator phase tracking (independent per voice - free-running)
-    float osc1Phase = 0.0f, osc2Phase = 0.0f, subOscPhase = 0.0f;
     
     // For poly mode: Per-voice velocity and aftertouch tracking (independent per note)
     float velocity = 0.0f;  // 0-1, from MIDI note-on velocity
     float aftertouch = 0.0f;  // 0-1, from MIDI note aftertouch (per-note polyphonic aftertouch)
-    
-    // For paraphonic modes: Amp gate for this voice (gates the oscillators on/off)
-    // Independent of the shared monoAmpEnv envelope
-    juce::ADSR ampGate;
-    
-    // For poly mode: Per-voice filter and envelopes (complete signal chain)
-    juce::dsp::LadderFilter<float> filter;
-    juce::ADSR filterEnv;
-    juce::ADSR ampEnv;
-    juce::ADSR pitchEnv; // Per-voice pitch envelope
-    
-    // Portamento/glide for smooth pitch transitions
-    juce::SmoothedValue<float> pitchGlide;
-    
-    // Buffer for rendering this voice's signal (before shared processing in para modes)
-    juce::AudioBuffer<float> voiceBuffer;
 };
 
-class Neon37AudioProcessor : public juce::AudioProcessor
+// Per-sample state for one group of neon37VoiceLaneWidth voices, rendered together at SIMD width.
+// Voice v is lane v % neon37VoiceLaneWidth of group v / neon37VoiceLaneWidth.
+struct Neon37VoiceGroup
+{
+    Neon37VoiceLanes lanes;                                       // Phases, glide, gates, envelopes
+    Neon37LadderFilter<neon37VoiceLaneWidth> filters;             // Poly: one filter lane per voice
+    Neon37NoiseGenerator<neon37VoiceLaneWidth> noise;             // Poly: one noise stream per voice
+    std::array<Neon37UnisonStack, neon37VoiceLaneWidth> unison;   // Para/Poly: one unison stack per voice
+};
+
+static_assert (Neon37DerivedParameters::maxUnison == Neon37UnisonStack::numLanes, "Unison copies are one stack lane each");
+
+// Preallocated scratch memory for processBlock
+// Sized once in prepareToPlay for the maximum block size. Every render path borrows views into it,
+// so a steady-state processBlock never touches the heap. The voice chain is mono: the host's
+// channel layout only appears when the mix is written to the output buffer.
+struct Neon37ScratchArena
+{
+    // Single-channel lanes for per-sample control signals
+    enum Lane
+    {
+        ampEnvLane = 0,     // Shared amp envelope (Mono/Para)
+        filterEnvLane,      // Shared filter envelope (Mono/Para)
+        pitchEnvLane,       // Shared pitch envelope (Mono/Para)
+        noiseLane,          // White noise for the shared voice path (Mono/Para)
+        lfoPitchLane,       // Summed LFO modulation per destination (pitch in octaves), mod wheel scaling applied
+        lfoFilterLane,
+        lfoAmpLane,
+        lfoWaveLane,        // One LFO's waveform while the sums are built
+        numLanes
+    };
+
+    // numVoiceBuffers: voice groups that can render at the same time (one per group when Poly
+    // rendering is split across threads, otherwise 1)
+    void prepare (int maxBlockSize, int numVoiceBuffers)
+    {
+        maxSamples = juce::jmax (1, maxBlockSize);
+
+        // Layout: [mono mix][lanes]
+        storage.setSize (1 + numLanes, maxSamples, false, true, false);
+        voiceFrameStorage.setSize (numVoiceBuffers, maxSamples * neon37VoiceLaneWidth, false, true, false);
+        voiceMixStorage.setSize (numVoiceBuffers, maxSamples, false, true, false);
+    }
+
+    // Start a block of numSamples: the renderers add into a cleared mono mix
+    void beginBlock (int numSamples)
+    {
+        jassert (numSamples <= maxSamples);  // Host exceeded the block size announced in prepareToPlay
+        storage.clear (0, 0, numSamples);
+    }
+
+    // Working buffer for the synth mix (one channel; fanned out to the host's channels at the end)
+    float* getMonoMix() { return storage.getWritePointer (0); }
+
+    // One voice group's signals interleaved by lane: sample s of lane v is at [s * neon37VoiceLaneWidth + v]
+    float* getVoiceFrames (int buffer = 0) { return voiceFrameStorage.getWritePointer (buffer); }
+
+    // One voice group's mix, summed into the mono mix after a threaded render
+    float* getVoiceMix (int buffer) { return voiceMixStorage.getWritePointer (buffer); }
+    float* getLane (Lane lane) { return storage.getWritePointer (1 + (int)lane); }
+
+private:
+    juce::AudioBuffer<float> storage;
+    juce::AudioBuffer<float> voiceFrameStorage;
+    juce::AudioBuffer<float> voiceMixStorage;
+    int maxSamples = 0;
+};
+
+class Neon37AudioProcessor : public juce::AudioProcessor,
+                             private juce::Timer
 {
 public:
     Neon37AudioProcessor();
@@ -97,31 +152,59 @@ private:
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     // DSP Components - for MONO modes
-    juce::dsp::LadderFilter<float> monoFilter;
+    Neon37LadderFilter<1> monoFilter;
     juce::dsp::Gain<float> outputGain;
-    juce::ADSR monoFilterEnv;
-    juce::ADSR monoAmpEnv;
-    juce::ADSR monoPitchEnv;
+    Neon37Envelope monoFilterEnv;
+    Neon37Envelope monoAmpEnv;
+    Neon37Envelope monoPitchEnv;
     
-    // Oversampling for alias-free oscillators (4x oversampling)
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversamplingUp;
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversamplingDown;
+    // HQ mode: the voice chain runs at oversamplingFactor x the host rate and is decimated back
+    // down at the output. Only allocated while enabled (hq_mode); changes are applied by re-preparing.
+    std::unique_ptr<Neon37Decimator> decimator;
+    int oversamplingOrder = 0;   // 0: off, 1: 2x, 2: 4x, 3: 8x
+    int oversamplingFactor = 1;
+    int preparedBlockSize = 0;   // Host block size from the last prepareToPlay (0 while released)
     
-    // Cache envelope parameters to avoid updating every block
-    float cachedEnv1Attack = -1.0f, cachedEnv1Decay = -1.0f, cachedEnv1Sustain = -1.0f, cachedEnv1Release = -1.0f;
-    float cachedEnv2Attack = -1.0f, cachedEnv2Decay = -1.0f, cachedEnv2Sustain = -1.0f, cachedEnv2Release = -1.0f;
-    float cachedEnvPitchAttack = -1.0f, cachedEnvPitchDecay = -1.0f, cachedEnvPitchSustain = -1.0f, cachedEnvPitchRelease = -1.0f;
-
-    double currentSampleRate = 44100.0;
+    // MIDI of one chunk of a host block larger than preparedBlockSize (reserved in prepareToPlay;
+    // events past the reservation are dropped). MidiBuffer stores each event behind a header of
+    // its sample position and size.
+    static constexpr size_t oversizedBlockMidiBytes = 16384;
+    static constexpr size_t midiEventHeaderBytes = sizeof(int32_t) + sizeof(uint16_t);
+    juce::MidiBuffer oversizedBlockMidi;
+    
+    // Poly rendering threads (poly_threads): active voice groups are split between voiceWorkers and
+    // the audio thread. Workers are started in prepareToPlay; changes are applied by re-preparing.
+    Neon37WorkerPool voiceWorkers;
+    int polyThreads = 1;
+    
+    // Render-ahead (render_ahead): the engine runs on its own thread in chunks of renderAheadChunkSize
+    // host samples, reported as two chunks of extra latency. 0 renders in the host callback.
+    Neon37RenderAhead renderAhead;
+    int renderAheadChunkSize = 0;
     
-    // Portamento/glide for smooth pitch transitions (Hz)
+    // Parameter handles (resolved once) and the typed snapshot render code reads each block
+    Neon37ParameterTable parameterTable;
+    Neon37ParameterSnapshot params;
+
+    // Derived values (tuning ratios, gains, envelope settings), recomputed only on parameter change
+    Neon37DerivedParameters derived;
+
+    // Band-limited wavetables shared by all instances (wavetable oscillator engine)
+    const Neon37WavetableBank* wavetables = nullptr;
+
+    double currentSampleRate = 44100.0;  // Engine rate: host rate x oversamplingFactor
+
+    // Scratch memory for processBlock (sized in prepareToPlay)
+    Neon37ScratchArena scratch;
+
+    // Portamento/glide for smooth pitch transitions, in log2(Hz) so the ramp is exponential in frequency
     juce::SmoothedValue<float> monoPitchGlide;
 
-    // Last played frequency used as deterministic glide source for Para/Poly (Hz)
-    float lastGlideFreqHz = 440.0f;
+    // Last played pitch used as deterministic glide source for Para/Poly (log2 Hz)
+    float lastGlidePitch = Neon37VoiceLanes::noteToPitch(69);
     
-    // Oscillator phase tracking - for MONO modes
-    float osc1Phase = 0.0f, osc2Phase = 0.0f, subOscPhase = 0.0f;
+    // Oscillator phase accumulators - for MONO modes (see Neon37Phase; the sub derives from osc 1)
+    uint32_t osc1Phase = 0, osc2Phase = 0, subOscBit = 0;
     
     // MIDI note tracking - for MONO modes
     int currentMidiNote = 60; // Middle C
@@ -132,11 +215,27 @@ private:
     std::array<bool, 128> keysDown{};
     int keysDownCount = 0;
     
-    // Paraphonic voices (8 voices max)
-    static constexpr int MAX_VOICES = 8;
-    std::array<Neon37Voice, MAX_VOICES> voices;
-    uint64_t voiceAllocationCounter = 0;  // Incremented on each voice allocation to track age
-    bool lastBlockHadAnyActiveVoices = false;  // Track if previous block had active voices (for envelope retrigger logic)
+    // Paraphonic/poly voice pool: MAX_VOICES voices, allocated once in prepareToPlay; voice_count
+    // limits how many the allocator hands out. Only groups with an active voice are rendered.
+    static constexpr int MAX_VOICES = neon37MaxVoices;
+    static constexpr int VOICE_LANES = neon37VoiceLaneWidth;
+    static constexpr int NUM_VOICE_GROUPS = MAX_VOICES / VOICE_LANES;
+    static constexpr int CONTROL_BLOCK_SIZE = NEON37_CONTROL_BLOCK_SIZE;
+    static_assert (CONTROL_BLOCK_SIZE > 0, "NEON37_CONTROL_BLOCK_SIZE must be positive");
+    // Threaded Poly rendering only pays off with at least two groups to split and a segment long
+    // enough to outweigh the dispatch; otherwise the audio thread renders alone
+    static constexpr int MIN_PARALLEL_GROUPS = 2;
+    static constexpr int MIN_PARALLEL_SAMPLES = 32;
+    int controlBlockSize = CONTROL_BLOCK_SIZE;  // In engine samples (same duration at any oversampling factor)
+    std::vector<Neon37Voice> voices;
+    std::vector<Neon37VoiceGroup> voiceGroups;  // Per-sample voice state, one lane per entry of voices
+    int voiceCount = 8;  // Voices currently available to the allocator (voice_count)
+    Neon37VoiceAllocator<MAX_VOICES> voiceAllocator;  // Free list, note -> voice table and stealing (voice_steal)
+    bool lastSegmentHadAnyActiveVoices = false;  // Track if voices were active before the current event (for envelope retrigger logic)
+    
+    // Silence tracking: blocks where nothing sounds are skipped without rendering
+    bool outputSilent = false;   // The last block was silent from start to end
+    bool idle = false;           // Blocks are currently being skipped
     
     // Global LFO modulation
     Neon37LFO lfo1;
@@ -150,29 +249,119 @@ private:
     float pitchBendValue = 0.0f;  // -1 to +1, from MIDI pitch bend
     float modWheelValueRaw = 0.0f;  // 0-1, from MIDI CC1 (raw mod wheel value, separate from modWheelValue which is used for LFO scaling)
     
-    // Generate envelope values for paraphonic mode
-    // Continue processing as long as envelopes are still active (releasing)    
-    juce::Random random;
-
-    // Helper function to generate waveform samples
-    float generateWaveform(float phase, int waveformType);
+    // White noise for the shared Mono/Para path (Poly voices have their own streams in their group).
+    // Re-seeded in prepareToPlay so renders are reproducible.
+    static constexpr uint32_t noiseSeed = 0x4e33375u, voiceNoiseSeed = 0x564f4943u;
+    Neon37NoiseGenerator<VOICE_LANES> noise;
     
-    // Helper function to generate LFO waveforms
-    float generateLFOWaveform(float phase, int waveformType);
+    // Unison stack for the Mono voice (Para/Poly voices have theirs in their group)
+    Neon37UnisonStack monoUnison;
+
+    // Helper function to generate bandlimited waveform samples (phase and increment in cycles)
+    // morph (0-1) blends toward the next waveform in wavetable mode
+    float generateWaveform(float phase, float phaseIncrement, int waveformType, float morph);
+    // Same for every voice lane at once (phases and increments in cycles)
+    void renderOscillatorLanes(int waveformType, float morph, const float* phases, const float* increments, float* out);
     
     // Helper to convert sync index (0-10) to time multiplier
     float getSyncMultiplier(int syncIndex);
     
+    // Glide length in seconds from sourcePitch to targetPitch (log2 Hz) for the glide_time/glide_rate settings
+    float getGlideSeconds(float sourcePitch, float targetPitch) const;
+    
+    // Oscillator waveforms, morphs, mixer levels and sync, shared by every voice in a segment
+    struct OscillatorSettings {
+        int osc1Wave, osc2Wave;
+        float osc1Morph, osc2Morph;
+        float mixerOsc1, mixerOsc2, mixerSub1;
+        bool hardSync;
+    };
+    OscillatorSettings getOscillatorSettings() const;
+    // One sample of a voice's unison stack (unison_voices > 1): every copy at its detune offset,
+    // rendered across the stack's lanes and mixed down. osc1Pitch/osc2Pitch are the voice's
+    // log2 phase increments (cycles per sample), as the single-oscillator paths compute them.
+    float renderUnisonSample(Neon37UnisonStack& stack, float osc1Pitch, float osc2Pitch, const OscillatorSettings& oscillators);
+    
     // Refactored helper functions for cleaner processBlock
+    // Velocity/aftertouch/mod wheel/bend modulation (derived.modMatrix routes) is constant over a
+    // segment; the LFOs add a per-sample part (buffers indexed by engine sample, like the scratch
+    // lanes they point into)
     struct ModulationState {
         float pitchModSemitones;
-        float totalFilterModMultiplier;
-        float totalAmpModMultiplier;
+        float filterMod, ampMod;
+        const float* lfoPitchOctaves;
+        const float* lfoFilterMod;
+        const float* lfoAmpMod;
+        
+        float filterModMultiplierAt(int sample) const { return 1.0f + juce::jlimit(-5.0f, 5.0f, filterMod + lfoFilterMod[sample]); }
+        float ampModMultiplierAt(int sample) const    { return 1.0f + juce::jlimit(-1.0f, 1.0f, ampMod + lfoAmpMod[sample]); }
     };
     
-    void calculateAllModulations(ModulationState& modState, float lfoFilterMod, float lfoPitchMod, float lfoAmpMod, float modWheelScale);
+    // Current controller values as matrix sources (the per-sample sources are left at 0)
+    Neon37ModulationMatrix::SourceValues getControlSourceValues() const;
+    void calculateAllModulations(ModulationState& modState, int voiceMode);
+    // Scales the shared amp envelope (Mono/Para) by all amplitude modulations, per sample
+    void applyAmpModulation(float* ampEnvBuffer, int startSample, int numSamples, const ModulationState& modState) const;
+    // Renders both LFOs for the segment and sums them per destination into the LFO lanes
+    void renderLFOs(int startSample, int numSamples, float modWheelScale, ModulationState& modState);
     float calculateModulatedCutoff(float baseCutoff, float filterEnvValue, float egDepth, float totalFilterModMultiplier, float resonance) const;
-    int allocateVoice();
+    int allocateVoice(int midiNote, int voiceMode);
+    void freeVoice(int voice);
+    
+    // Voice pool addressing: the group holding a voice, and its lane within the group
+    Neon37VoiceGroup& groupOf(int voice) { return voiceGroups[(size_t)(voice / VOICE_LANES)]; }
+    static int laneOf(int voice) { return voice % VOICE_LANES; }
+    bool isGroupActive(int group) const;
+    void setVoiceCount(int newVoiceCount);
+
+    // processBlock stages: events are applied at their sample position, audio between them is rendered as a segment
+    void handleMidiEvent(const juce::MidiMessage& msg, int voiceMode);
+    void renderSegment(int startSample, int numSamples, int voiceMode);
+    void renderMonoSegment(int startSample, int numSamples, const ModulationState& modState);
+    void renderParaphonicSegment(int startSample, int numSamples, const ModulationState& modState);
+    void renderPolySegment(int startSample, int numSamples, const ModulationState& modState);
+    
+    // Poly segment values shared by every voice group, computed once so a group can render on any thread
+    struct PolySegmentSettings {
+        int startSample, endSample;
+        OscillatorSettings oscillators;
+        float mixerNoise;
+        float baseCutoff, resonance, egDepth, drive;
+        float osc1PitchOffset, osc2PitchOffset, osc1PitchEgOctaves, osc2PitchEgOctaves;
+        float filterMod, ampMod;  // Channel controller modulation (each voice adds its own velocity/aftertouch)
+        const float* lfoPitchOctaves;
+        const float* lfoFilterMod;
+        const float* lfoAmpMod;
+    };
+    struct PolyGroupJobs {
+        Neon37AudioProcessor* processor;
+        const PolySegmentSettings* settings;
+        const int* groups;  // Job i renders group groups[i]
+    };
+    // Renders one group's voices and adds them into mix (touches only that group's state)
+    void renderPolyGroup(int group, const PolySegmentSettings& settings, float* voiceFrames, float* mix);
+    static void renderPolyGroupJob(void* context, int job);
+    static int getPolyThreadCount(int polyThreadsChoice) { return 1 << juce::jlimit(0, 3, polyThreadsChoice); }
+    
+    // One host block of at most preparedBlockSize samples: rendered directly, or handed to render-ahead
+    void renderHostBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
+    // One engine block (host rate, up to the prepared engine block size): what renderHostBlock runs
+    // directly, or what the render-ahead worker runs per chunk
+    void renderEngineBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
+    static void renderAheadChunk(void* context, juce::AudioBuffer<float>& chunk, juce::MidiBuffer& midi);
+    static int getRenderAheadChunkSize(int renderAheadChoice) { return renderAheadChoice > 0 ? 128 << juce::jlimit(1, 3, renderAheadChoice) : 0; }
+    void processMonoFilterSubBlock(int startSample, int numSamples, float cutoffHz, float resonance, float drive);
+    void writeOutput(juce::AudioBuffer<float>& buffer, const float* monoMix, int numSamples);
+    
+    // Idle handling: whether anything can reach the output, the skipped-block path, and culling
+    // of the shared envelopes once the amp envelope falls below cull_floor
+    bool isSilent(int voiceMode) const;
+    void skipSilentBlock(juce::AudioBuffer<float>& buffer, int numEngineSamples);
+    void advanceLFOs(int numSamples);
+    void cullMonoEnvelopes();
+
+    // Applies hq_mode, poly_threads and render_ahead changes (re-prepares on the message thread with processing suspended)
+    void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Neon37AudioProcessor)
 };
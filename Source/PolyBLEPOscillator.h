@@ -0,0 +1,189 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "FastMath.h"
+#include <cmath>
+
+// Bandlimited oscillator waveforms using polynomial residuals (polyBLEP / polyBLAMP).
+// The naive waveform is corrected around each discontinuity: polyBLEP smooths jumps in value
+// (saw, square, pulses), polyBLAMP smooths jumps in slope (triangle). The correction spans the
+// samples on either side of the edge, so its width follows the phase increment automatically.
+// Waveform indices match the osc*_wave parameters.
+struct Neon37PolyBLEP
+{
+    enum Waveform
+    {
+        sine = 0,
+        triangle,
+        sawtooth,
+        square,
+        pulse25,
+        pulse10
+    };
+
+    // Residual of a unit-height step at phase 0 (scaled so a jump of 2 is corrected by 1)
+    // t: normalized phase [0, 1), dt: phase increment in cycles per sample
+    static inline float blep (float t, float dt) noexcept
+    {
+        if (t < dt)
+        {
+            t /= dt;
+            return t + t - t * t - 1.0f;
+        }
+
+        if (t > 1.0f - dt)
+        {
+            t = (t - 1.0f) / dt;
+            return t * t + t + t + 1.0f;
+        }
+
+        return 0.0f;
+    }
+
+    // Residual of a slope change of 2 per sample at phase 0 (the integral of blep, same scaling)
+    static inline float blamp (float t, float dt) noexcept
+    {
+        if (t < dt)
+        {
+            t = t / dt - 1.0f;
+            return -(1.0f / 3.0f) * t * t * t;
+        }
+
+        if (t > 1.0f - dt)
+        {
+            t = (t - 1.0f) / dt + 1.0f;
+            return (1.0f / 3.0f) * t * t * t;
+        }
+
+        return 0.0f;
+    }
+
+    // Wrap a normalized phase offset back into [0, 1)
+    static inline float wrap (float t) noexcept
+    {
+        return t >= 1.0f ? t - 1.0f : t;
+    }
+
+    // Pulse of the given width: +1 for t < width, -1 after, both edges corrected
+    static inline float pulse (float t, float dt, float width) noexcept
+    {
+        float sample = t < width ? 1.0f : -1.0f;
+        sample += blep (t, dt);
+        sample -= blep (wrap (t + 1.0f - width), dt);
+        return sample;
+    }
+
+    // One sample of the waveform at normalized phase t (cycles) advancing by dt per sample
+    static inline float render (int waveform, float t, float dt) noexcept
+    {
+        // The residuals assume an edge is at most one sample wide on each side
+        dt = juce::jlimit (1.0e-6f, 0.5f, dt);
+
+        switch (waveform)
+        {
+            case triangle:
+            {
+                // Peak at t = 0 (slope changes by -8 per cycle), trough at t = 0.5 (+8)
+                float sample = 4.0f * std::abs (t - 0.5f) - 1.0f;
+                const float slopeStep = 4.0f * dt;  // Half the per-sample slope change (blamp scaling)
+                sample -= slopeStep * blamp (t, dt);
+                sample += slopeStep * blamp (wrap (t + 0.5f), dt);
+                return sample;
+            }
+
+            case sawtooth:
+                return 2.0f * t - 1.0f - blep (t, dt);
+
+            case square:    return pulse (t, dt, 0.5f);
+            case pulse25:   return pulse (t, dt, 0.25f);
+            case pulse10:   return pulse (t, dt, 0.10f);
+
+            case sine:
+            default:
+                return Neon37FastMath::sin2Pi (t);
+        }
+    }
+
+    //==============================================================================
+    // Branch-free residual (both edges evaluated, then selected) for the lane renderer
+    static inline float blepSelect (float t, float dt, float invDt) noexcept
+    {
+        const float head = t * invDt;
+        const float tail = (t - 1.0f) * invDt;
+        const float headResidual = head + head - head * head - 1.0f;
+        const float tailResidual = tail * tail + tail + tail + 1.0f;
+        float residual = t > 1.0f - dt ? tailResidual : 0.0f;
+        residual = t < dt ? headResidual : residual;
+        return residual;
+    }
+
+    static inline float blampSelect (float t, float dt, float invDt) noexcept
+    {
+        const float head = t * invDt - 1.0f;
+        const float tail = (t - 1.0f) * invDt + 1.0f;
+        const float headResidual = -(1.0f / 3.0f) * head * head * head;
+        const float tailResidual = (1.0f / 3.0f) * tail * tail * tail;
+        float residual = t > 1.0f - dt ? tailResidual : 0.0f;
+        residual = t < dt ? headResidual : residual;
+        return residual;
+    }
+
+    static inline float pulseSelect (float t, float dt, float invDt, float width) noexcept
+    {
+        const float shifted = t + 1.0f - width;
+        const float t2 = shifted >= 1.0f ? shifted - 1.0f : shifted;
+        const float naive = t < width ? 1.0f : -1.0f;
+        return naive + blepSelect (t, dt, invDt) - blepSelect (t2, dt, invDt);
+    }
+
+    // One sample for numLanes voices at once: same waveforms as render(), with the waveform
+    // switch hoisted out of the lane loop so each loop body is branch-free and vectorizes.
+    template <int numLanes>
+    static void renderLanes (int waveform, const float* t, const float* increment, float* out) noexcept
+    {
+        auto forEachLane = [&] (auto&& kernel)
+        {
+            for (int i = 0; i < numLanes; ++i)
+            {
+                const float dt = std::min (std::max (increment[i], 1.0e-6f), 0.5f);
+                out[i] = kernel (t[i], dt, 1.0f / dt);
+            }
+        };
+
+        switch (waveform)
+        {
+            case triangle:
+                forEachLane ([] (float p, float dt, float invDt)
+                {
+                    const float slopeStep = 4.0f * dt;
+                    const float half = p + 0.5f;
+                    return 4.0f * std::abs (p - 0.5f) - 1.0f
+                         - slopeStep * blampSelect (p, dt, invDt)
+                         + slopeStep * blampSelect (half >= 1.0f ? half - 1.0f : half, dt, invDt);
+                });
+                break;
+
+            case sawtooth:
+                forEachLane ([] (float p, float dt, float invDt) { return 2.0f * p - 1.0f - blepSelect (p, dt, invDt); });
+                break;
+
+            case square:
+                forEachLane ([] (float p, float dt, float invDt) { return pulseSelect (p, dt, invDt, 0.5f); });
+                break;
+
+            case pulse25:
+                forEachLane ([] (float p, float dt, float invDt) { return pulseSelect (p, dt, invDt, 0.25f); });
+                break;
+
+            case pulse10:
+                forEachLane ([] (float p, float dt, float invDt) { return pulseSelect (p, dt, invDt, 0.10f); });
+                break;
+
+            case sine:
+            default:
+                for (int i = 0; i < numLanes; ++i)
+                    out[i] = Neon37FastMath::sin2Pi (t[i]);
+                break;
+        }
+    }
+};
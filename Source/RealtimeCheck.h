@@ -0,0 +1,23 @@
+#pragma once
+
+// Hooks for the Neon37_RTCheck real-time-safety build (tools/rtcheck).
+// processBlock marks its thread as the audio thread for its whole duration; the RTCheck
+// interposer then reports any allocation, lock or blocking call made while the mark is set.
+// In normal builds NEON37_REALTIME_SCOPE compiles to nothing.
+#if NEON37_RTCHECK
+struct Neon37RealtimeCheck
+{
+    static void enterAudioThread() noexcept;
+    static void exitAudioThread() noexcept;
+
+    struct ScopedAudioThread
+    {
+        ScopedAudioThread() noexcept { enterAudioThread(); }
+        ~ScopedAudioThread() noexcept { exitAudioThread(); }
+    };
+};
+
+ #define NEON37_REALTIME_SCOPE Neon37RealtimeCheck::ScopedAudioThread neon37RealtimeScope;
+#else
+ #define NEON37_REALTIME_SCOPE
+#endif
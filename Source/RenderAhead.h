@@ -0,0 +1,261 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "RealtimeCheck.h"
+#include "WorkerPool.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Render-ahead: the synth engine runs on its own thread in fixed chunks instead of inside the
+// host callback. process() (the audio thread) only queues the block's MIDI and copies finished
+// audio out of a ring buffer:
+//  - MIDI goes through a single-producer/single-consumer queue, stamped with its host sample time
+//  - chunk k (host samples [k * chunkSize, (k + 1) * chunkSize)) can be rendered once the host
+//    has passed its end, i.e. all of its MIDI has arrived; the worker is woken to render it
+//  - the output runs two chunks behind the host (getLatencySamples), one chunk to collect the
+//    MIDI and one for the worker to render it
+// Chunks render strictly in order, by whichever thread holds the render token. If a chunk the
+// output needs is not finished, the audio thread takes the token and renders it inline (or waits
+// out the chunk the worker is finishing), so an underrun costs time, never a dropout.
+class Neon37RenderAhead
+{
+public:
+    // Renders one chunk of the engine (mono, host rate) with its MIDI at chunk-relative positions
+    using RenderFunction = void (*) (void* context, juce::AudioBuffer<float>& chunk, juce::MidiBuffer& midi);
+
+    ~Neon37RenderAhead() { stop(); }
+
+    // Message thread, with the audio callback stopped. maxBlockSize is the largest host block.
+    void start (int newChunkSize, int maxBlockSize, RenderFunction function, void* context,
+                const juce::Thread::RealtimeOptions& options)
+    {
+        stop();
+
+        chunkSize = newChunkSize;
+        renderFunction = function;
+        renderContext = context;
+
+        // Unread audio spans at most the latency plus one host block; whole chunks keep each write contiguous
+        const int ringChunks = 3 + (maxBlockSize + chunkSize - 1) / chunkSize;
+        ring.assign ((size_t)(ringChunks * chunkSize), 0.0f);
+        chunkBuffer.setSize (1, chunkSize);
+        chunkMidi.ensureSize (midiQueueSize * 16);
+
+        hostTime = 0;
+        chunksRequested.store (0);
+        chunksDone.store (0);
+        midiWrite.store (0);
+        midiRead.store (0);
+        renderToken.store (false);
+        quit.store (false);
+
+        worker = std::make_unique<Worker> (*this);
+        if (! worker->startRealtimeThread (options))
+            worker->startThread (juce::Thread::Priority::highest);
+    }
+
+    void stop()
+    {
+        if (worker == nullptr)
+            return;
+
+        quit.store (true);
+        wake.fetch_add (1);
+        wake.notify_all();
+        worker->stopThread (-1);
+        worker.reset();
+        chunkSize = 0;
+    }
+
+    bool isActive() const noexcept { return worker != nullptr; }
+    int getLatencySamples() const noexcept { return 2 * chunkSize; }
+
+    // Audio thread: queue the block's MIDI and fill buffer with the engine output from the latency ago
+    void process (juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi) noexcept
+    {
+        const int numSamples = buffer.getNumSamples();
+
+        for (const auto metadata : midi)
+            pushMidi (hostTime + juce::jlimit (0, numSamples - 1, metadata.samplePosition), metadata.data, metadata.numBytes);
+
+        const int64_t outputStart = hostTime - getLatencySamples();
+        hostTime += numSamples;
+        chunksRequested.store (hostTime / chunkSize, std::memory_order_release);
+
+        wake.fetch_add (1, std::memory_order_release);
+        if (numParked.load() > 0)
+            wake.notify_one();
+
+        // Underrun: render (or wait for) whatever the worker has not finished yet
+        const int64_t outputEnd = outputStart + numSamples;
+        const int64_t chunksNeeded = outputEnd > 0 ? (outputEnd + chunkSize - 1) / chunkSize : 0;
+        while (chunksDone.load (std::memory_order_acquire) < chunksNeeded)
+        {
+            if (! renderChunks (chunksNeeded))
+                Neon37WorkerPool::pause();
+        }
+
+        if (buffer.getNumChannels() == 0)
+            return;
+
+        float* out = buffer.getWritePointer (0);
+        const int64_t ringSize = (int64_t)ring.size();
+        for (int i = 0; i < numSamples;)
+        {
+            const int64_t t = outputStart + i;
+            if (t < 0)
+            {
+                // Before the first chunk: the latency period is silent
+                const int silent = (int)juce::jmin ((int64_t)(numSamples - i), -t);
+                juce::FloatVectorOperations::clear (out + i, silent);
+                i += silent;
+                continue;
+            }
+
+            const int ringPos = (int)(t % ringSize);
+            const int count = (int)juce::jmin ((int64_t)(numSamples - i), ringSize - ringPos);
+            juce::FloatVectorOperations::copy (out + i, ring.data() + ringPos, count);
+            i += count;
+        }
+
+        for (int channel = 1; channel < buffer.getNumChannels(); ++channel)
+            buffer.copyFrom (channel, 0, buffer, 0, 0, numSamples);
+    }
+
+private:
+    struct QueuedMidi
+    {
+        int64_t time = 0;
+        uint8_t bytes[3] {};
+        int numBytes = 0;
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        explicit Worker (Neon37RenderAhead& owner) : juce::Thread ("Neon37 render-ahead"), renderAhead (owner) {}
+
+        void run() override
+        {
+            juce::ScopedNoDenormals noDenormals;
+            renderAhead.workerLoop();
+        }
+
+    private:
+        Neon37RenderAhead& renderAhead;
+    };
+
+    static constexpr int midiQueueSize = 1024;
+    static constexpr int spinsBeforeParking = 20000;
+
+    // Channel-voice messages only (the engine ignores sysex); dropped if the queue is full
+    void pushMidi (int64_t time, const uint8_t* data, int numBytes) noexcept
+    {
+        const int64_t write = midiWrite.load (std::memory_order_relaxed);
+        if (numBytes <= 0 || numBytes > 3 || write - midiRead.load (std::memory_order_acquire) >= midiQueueSize)
+            return;
+
+        auto& event = midiQueue[(size_t)(write % midiQueueSize)];
+        event.time = time;
+        event.numBytes = numBytes;
+        for (int i = 0; i < numBytes; ++i)
+            event.bytes[i] = data[i];
+
+        midiWrite.store (write + 1, std::memory_order_release);
+    }
+
+    void workerLoop()
+    {
+        uint32_t seen = wake.load();
+
+        for (;;)
+        {
+            for (int spin = 0; wake.load (std::memory_order_acquire) == seen && spin < spinsBeforeParking; ++spin)
+                Neon37WorkerPool::pause();
+
+            if (wake.load (std::memory_order_acquire) == seen)
+            {
+                numParked.fetch_add (1);
+                wake.wait (seen);
+                numParked.fetch_sub (1);
+            }
+
+            if (quit.load())
+                return;
+
+            seen = wake.load (std::memory_order_acquire);
+            renderChunks (std::numeric_limits<int64_t>::max());
+        }
+    }
+
+    // Render requested chunks in order up to (not including) chunk limit. Returns false without
+    // doing anything if another thread holds the render token.
+    bool renderChunks (int64_t limit) noexcept
+    {
+        if (renderToken.exchange (true, std::memory_order_acquire))
+            return false;
+
+        NEON37_REALTIME_SCOPE
+        const int64_t requested = juce::jmin (limit, chunksRequested.load (std::memory_order_acquire));
+        for (int64_t chunk = chunksDone.load (std::memory_order_relaxed); chunk < requested; ++chunk)
+            renderChunk (chunk);
+
+        renderToken.store (false, std::memory_order_release);
+        return true;
+    }
+
+    void renderChunk (int64_t chunk) noexcept
+    {
+        const int64_t chunkStart = chunk * chunkSize;
+        const int64_t chunkEnd = chunkStart + chunkSize;
+
+        // This chunk's MIDI (events arrive in time order, and every earlier chunk took its own)
+        chunkMidi.clear();
+        const int64_t available = midiWrite.load (std::memory_order_acquire);
+        int64_t read = midiRead.load (std::memory_order_relaxed);
+        for (; read < available; ++read)
+        {
+            const auto& event = midiQueue[(size_t)(read % midiQueueSize)];
+            if (event.time >= chunkEnd)
+                break;
+
+            chunkMidi.addEvent (event.bytes, event.numBytes, (int)(event.time - chunkStart));
+        }
+        midiRead.store (read, std::memory_order_release);
+
+        chunkBuffer.clear();
+        renderFunction (renderContext, chunkBuffer, chunkMidi);
+
+        const int ringPos = (int)(chunkStart % (int64_t)ring.size());
+        juce::FloatVectorOperations::copy (ring.data() + ringPos, chunkBuffer.getReadPointer (0), chunkSize);
+        chunksDone.store (chunk + 1, std::memory_order_release);
+    }
+
+    int chunkSize = 0;
+    RenderFunction renderFunction = nullptr;
+    void* renderContext = nullptr;
+
+    // Audio thread only
+    int64_t hostTime = 0;
+
+    // MIDI queue: written by the audio thread, read by the render token holder
+    std::array<QueuedMidi, midiQueueSize> midiQueue;
+    std::atomic<int64_t> midiWrite { 0 }, midiRead { 0 };
+
+    // Chunk bookkeeping and output ring (written by the render token holder)
+    std::atomic<int64_t> chunksRequested { 0 }, chunksDone { 0 };
+    std::atomic<bool> renderToken { false };
+    std::vector<float> ring;
+    juce::AudioBuffer<float> chunkBuffer;
+    juce::MidiBuffer chunkMidi;
+
+    // Worker wake-up: bumped per host block; 32-bit so a parked worker waits on a futex
+    std::atomic<uint32_t> wake { 0 };
+    std::atomic<int> numParked { 0 };
+    std::atomic<bool> quit { false };
+    std::unique_ptr<Worker> worker;
+};
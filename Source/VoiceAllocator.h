@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Voice bookkeeping for the Para/Poly modes, constant cost per MIDI event.
+//  - free list: voices ready to be handed out (only those below the current voice count)
+//  - note table: which voice is playing each MIDI note (note-off, poly aftertouch, retrigger)
+//  - the voices in use in allocation order, and the released ones (tails) in release order
+//  - draining voices: cut off by a lower voice count but still sounding, owned by nobody until
+//    the caller frees them
+// Allocation pops the free list; when it is empty a voice is stolen by the chosen policy.
+// Oldest and releasing-first read a list head; quietest compares the callers' current
+// levels, so it scans the voices in use (only when stealing).
+template <int maxVoices>
+class Neon37VoiceAllocator
+{
+public:
+    enum StealPolicy : int { oldest = 0, quietest, releasingFirst };
+
+    Neon37VoiceAllocator() { reset (maxVoices); }
+
+    // Every voice free, no notes playing
+    void reset (int newVoiceCount) noexcept
+    {
+        voiceCount = newVoiceCount;
+        noteToVoice.fill (-1);
+        inUse.clear();
+        released.clear();
+
+        numFree = 0;
+        for (int v = maxVoices; --v >= 0;)
+        {
+            voiceNote[(size_t)v] = -1;
+            state[(size_t)v] = freeVoice;
+            if (v < voiceCount)
+                freeList[(size_t)numFree++] = v;  // Lowest index on top
+        }
+    }
+
+    // Change how many voices may be handed out. Voices above the count stop being tracked and
+    // drain (the caller lets their tails finish): they are never stolen, and they only return to
+    // the free list through free(), even if the count is raised again before their tails end.
+    void setVoiceCount (int newVoiceCount) noexcept
+    {
+        voiceCount = newVoiceCount;
+
+        for (int v = voiceCount; v < maxVoices; ++v)
+        {
+            if (state[(size_t)v] == heldVoice || state[(size_t)v] == releasedVoice)
+            {
+                detach (v);
+                state[(size_t)v] = drainingVoice;
+            }
+        }
+
+        numFree = 0;
+        for (int v = voiceCount; --v >= 0;)
+            if (state[(size_t)v] == freeVoice)
+                freeList[(size_t)numFree++] = v;
+    }
+
+    // Voice currently playing midiNote, or -1
+    int voiceForNote (int midiNote) const noexcept
+    {
+        return (midiNote >= 0 && midiNote < 128) ? noteToVoice[(size_t)midiNote] : -1;
+    }
+
+    int getNoteOfVoice (int voice) const noexcept { return voiceNote[(size_t)voice]; }
+    bool isInUse (int voice) const noexcept       { return state[(size_t)voice] != freeVoice; }
+
+    // Hand out a voice for midiNote: a free one if any, otherwise the victim of policy.
+    // levelOf(voice) returns a voice's current output level (used by quietest).
+    // Returns the voice and sets wasStolen when it was taken from another note.
+    template <typename LevelFunction>
+    int allocate (int midiNote, StealPolicy policy, LevelFunction&& levelOf, bool& wasStolen) noexcept
+    {
+        int voice = -1;
+        wasStolen = numFree == 0;
+
+        if (! wasStolen)
+        {
+            voice = freeList[(size_t)--numFree];
+        }
+        else
+        {
+            voice = chooseVictim (policy, levelOf);
+            detach (voice);
+        }
+
+        voiceNote[(size_t)voice] = midiNote;
+        if (midiNote >= 0 && midiNote < 128)
+            noteToVoice[(size_t)midiNote] = voice;
+
+        inUse.pushBack (voice, ageLinks);
+        state[(size_t)voice] = heldVoice;
+        return voice;
+    }
+
+    // Key released: the voice keeps sounding (tail) but no longer owns its note
+    void noteReleased (int voice) noexcept
+    {
+        if (state[(size_t)voice] != heldVoice)
+            return;
+
+        unmapNote (voice);
+        released.pushBack (voice, releaseLinks);
+        state[(size_t)voice] = releasedVoice;
+    }
+
+    // Voice finished (tail over or cut): back to the free list if it is within the voice count
+    void free (int voice) noexcept
+    {
+        if (state[(size_t)voice] == freeVoice)
+            return;
+
+        detach (voice);
+
+        if (voice < voiceCount)
+            freeList[(size_t)numFree++] = voice;
+    }
+
+private:
+    enum VoiceState : uint8_t { freeVoice = 0, heldVoice, releasedVoice, drainingVoice };
+
+    struct Links
+    {
+        std::array<int, maxVoices> prev, next;
+    };
+
+    // Intrusive doubly linked list of voice indices, first added at the head
+    struct AgeList
+    {
+        int head = -1, tail = -1;
+
+        void clear() noexcept { head = tail = -1; }
+
+        void pushBack (int voice, Links& l) noexcept
+        {
+            l.prev[(size_t)voice] = tail;
+            l.next[(size_t)voice] = -1;
+            if (tail >= 0) l.next[(size_t)tail] = voice; else head = voice;
+            tail = voice;
+        }
+
+        void remove (int voice, Links& l) noexcept
+        {
+            const int p = l.prev[(size_t)voice], n = l.next[(size_t)voice];
+            if (p >= 0) l.next[(size_t)p] = n; else head = n;
+            if (n >= 0) l.prev[(size_t)n] = p; else tail = p;
+        }
+    };
+
+    template <typename LevelFunction>
+    int chooseVictim (StealPolicy policy, LevelFunction& levelOf) const noexcept
+    {
+        if (policy == releasingFirst && released.head >= 0)
+            return released.head;
+
+        if (policy == quietest)
+        {
+            // Oldest first, so ties go to the older voice
+            int victim = inUse.head;
+            float lowest = levelOf (victim);
+            for (int v = ageLinks.next[(size_t)victim]; v >= 0; v = ageLinks.next[(size_t)v])
+            {
+                const float level = levelOf (v);
+                if (level < lowest)
+                {
+                    victim = v;
+                    lowest = level;
+                }
+            }
+            return victim;
+        }
+
+        return inUse.head;
+    }
+
+    void detach (int voice) noexcept
+    {
+        unmapNote (voice);
+        voiceNote[(size_t)voice] = -1;
+
+        if (state[(size_t)voice] == releasedVoice)
+            released.remove (voice, releaseLinks);
+        if (state[(size_t)voice] != drainingVoice)
+            inUse.remove (voice, ageLinks);
+        state[(size_t)voice] = freeVoice;
+    }
+
+    void unmapNote (int voice) noexcept
+    {
+        const int note = voiceNote[(size_t)voice];
+        if (note >= 0 && note < 128 && noteToVoice[(size_t)note] == voice)
+            noteToVoice[(size_t)note] = -1;
+    }
+
+    int voiceCount = maxVoices;
+    std::array<int, maxVoices> freeList{};
+    int numFree = 0;
+
+    std::array<int, 128> noteToVoice{};
+    std::array<int, maxVoices> voiceNote{};
+    std::array<VoiceState, maxVoices> state{};
+
+    Links ageLinks{}, releaseLinks{};
+    AgeList inUse, released;  // Allocation order / release order
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "EnvelopeGenerator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Structure-of-arrays voice state for the Para/Poly renderers.
+// Every per-voice quantity the render loops touch each sample lives in its own aligned array,
+// indexed by voice ("lane"). The per-sample loops over lanes have a fixed trip count and no
+// branches, so the compiler turns them into SSE/AVX/NEON code (4 or 8 voices per instruction).
+// Inactive lanes are computed too and masked out where they are mixed.
+// Voices come in groups of neon37VoiceLaneWidth lanes; the pool holds up to neon37MaxVoices.
+
+static constexpr int neon37VoiceLaneWidth = 8;
+static constexpr int neon37MaxVoices = 64;
+static_assert (neon37MaxVoices % neon37VoiceLaneWidth == 0, "The voice pool must be whole lane groups");
+
+// Oscillator phase as an unsigned 32-bit fraction of a cycle: it wraps by integer overflow (no
+// branches, no drift over long notes), and a wrap shows up as a carry (the sum is below the old phase).
+struct Neon37Phase
+{
+    static constexpr uint32_t subOctaveBit = 0x80000000u;
+
+    // Accumulator step for an increment in cycles per sample (kept below Nyquist)
+    static inline uint32_t fromCycles (float increment) noexcept
+    {
+        return (uint32_t)(int32_t)(std::min (std::max (increment, 0.0f), 0.49999f) * 4294967296.0f);
+    }
+
+    // Phase in cycles, [0, 1); the top 24 bits convert to float exactly
+    static inline float toCycles (uint32_t phase) noexcept
+    {
+        return (float)(int32_t)(phase >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Sub oscillator phase: osc 1's accumulator divided by two, with subBit (toggled on every osc 1
+    // wrap) as the top bit, so the sub is exactly one octave below osc 1 and locked to it
+    static inline uint32_t divideByTwo (uint32_t osc1Phase, uint32_t subBit) noexcept
+    {
+        return subBit | (osc1Phase >> 1);
+    }
+};
+
+// Per-voice envelopes: every lane of a group stepped together (see Neon37EnvelopeGenerator)
+using Neon37EnvelopeLanes = Neon37EnvelopeGenerator<neon37VoiceLaneWidth>;
+
+// Oscillator set (osc 1, osc 2 and the sub) for every lane: the phase accumulators and their
+// per-sample read-out and update. A lane is a voice in Neon37VoiceLanes, a unison copy in Neon37UnisonStack.
+struct Neon37OscillatorLanes
+{
+    static constexpr int numLanes = neon37VoiceLaneWidth;
+    using LaneArray = std::array<float, numLanes>;
+    using PhaseArray = std::array<uint32_t, numLanes>;
+
+    // Oscillator phase accumulators (see Neon37Phase); the sub derives from osc 1 plus its octave bit
+    alignas (32) PhaseArray osc1Phase{};
+    alignas (32) PhaseArray osc2Phase{};
+    alignas (32) PhaseArray subBit{};
+
+    // Every lane's phases in cycles, for the waveform renderers
+    void getPhases (float* osc1, float* osc2, float* sub) const noexcept
+    {
+        for (int i = 0; i < numLanes; ++i)
+        {
+            osc1[i] = Neon37Phase::toCycles (osc1Phase[(size_t)i]);
+            osc2[i] = Neon37Phase::toCycles (osc2Phase[(size_t)i]);
+            sub[i] = Neon37Phase::toCycles (Neon37Phase::divideByTwo (osc1Phase[(size_t)i], subBit[(size_t)i]));
+        }
+    }
+
+    // Advance every lane's accumulators; an osc 1 carry flips the sub's octave bit and resets osc 2 when synced
+    void advancePhases (const uint32_t* osc1Step, const uint32_t* osc2Step, bool hardSync) noexcept
+    {
+        const uint32_t syncMask = hardSync ? 0xffffffffu : 0u;
+
+        for (int i = 0; i < numLanes; ++i)
+        {
+            const uint32_t p1 = osc1Phase[(size_t)i] + osc1Step[i];
+            const uint32_t p2 = osc2Phase[(size_t)i] + osc2Step[i];
+            const uint32_t carry = p1 < osc1Phase[(size_t)i] ? 0xffffffffu : 0u;
+
+            osc1Phase[(size_t)i] = p1;
+            osc2Phase[(size_t)i] = p2 & ~(carry & syncMask);
+            subBit[(size_t)i] ^= carry & Neon37Phase::subOctaveBit;
+        }
+    }
+};
+
+// Unison: up to neon37VoiceLaneWidth detuned copies of one voice's oscillator set, one copy per
+// lane, so every copy renders in the same vector operations
+struct Neon37UnisonStack : Neon37OscillatorLanes
+{
+    // Restart the first numCopies copies spread evenly over spread (0-1) of a cycle, copy 0 at phase 0
+    void spreadPhases (int numCopies, float spread) noexcept
+    {
+        for (int i = 0; i < numLanes; ++i)
+        {
+            const double cycles = i < numCopies ? (double)spread * i / numCopies : 0.0;
+            osc1Phase[(size_t)i] = osc2Phase[(size_t)i] = (uint32_t)(cycles * 4294967296.0);
+            subBit[(size_t)i] = 0;
+        }
+    }
+};
+
+struct Neon37VoiceLanes : Neon37OscillatorLanes
+{
+    // Portamento in log2(Hz): a linear ramp in pitch, so glides are exponential in frequency
+    alignas (32) LaneArray glideCurrent{};
+    alignas (32) LaneArray glideTarget{};
+    alignas (32) LaneArray glideStep{};
+    alignas (32) LaneArray glideCountdown{};
+
+    // Paraphonic gate: 1 while the voice's key is held, 0 after note-off
+    alignas (32) LaneArray gate{};
+
+    // Per-voice envelopes (poly mode)
+    Neon37EnvelopeLanes filterEnv, ampEnv, pitchEnv;
+
+    void prepare (double sampleRate)
+    {
+        filterEnv.setSampleRate (sampleRate);
+        ampEnv.setSampleRate (sampleRate);
+        pitchEnv.setSampleRate (sampleRate);
+
+        const float defaultPitch = noteToPitch (60);
+        for (int i = 0; i < numLanes; ++i)
+        {
+            setGlide (i, defaultPitch, defaultPitch, 0.0f);
+            gate[(size_t)i] = 0.0f;
+            filterEnv.reset (i);
+            ampEnv.reset (i);
+            pitchEnv.reset (i);
+        }
+    }
+
+    // Pitch of a MIDI note as log2(Hz) (A4 = 440 Hz)
+    static float noteToPitch (int midiNote) noexcept
+    {
+        return 8.78135971f + (float)(midiNote - 69) * (1.0f / 12.0f);
+    }
+
+    // Start a glide from sourcePitch to targetPitch (log2 Hz) over rampSamples (jumps when rampSamples < 1)
+    void setGlide (int lane, float sourcePitch, float targetPitch, float rampSamples)
+    {
+        const auto i = (size_t)lane;
+        const float steps = std::floor (rampSamples);
+
+        if (steps < 1.0f || sourcePitch == targetPitch)
+        {
+            glideCurrent[i] = glideTarget[i] = targetPitch;
+            glideStep[i] = glideCountdown[i] = 0.0f;
+            return;
+        }
+
+        glideCurrent[i] = sourcePitch;
+        glideTarget[i] = targetPitch;
+        glideCountdown[i] = steps;
+        glideStep[i] = (targetPitch - sourcePitch) / steps;
+    }
+
+    // Advance every lane's glide by one sample
+    void advanceGlide() noexcept
+    {
+        for (int i = 0; i < numLanes; ++i)
+        {
+            const float countdown = std::max (glideCountdown[(size_t)i] - 1.0f, 0.0f);
+            glideCountdown[(size_t)i] = countdown;
+            glideCurrent[(size_t)i] = countdown > 0.0f ? glideCurrent[(size_t)i] + glideStep[(size_t)i] : glideTarget[(size_t)i];
+        }
+    }
+};
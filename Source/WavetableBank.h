@@ -0,0 +1,151 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <vector>
+
+// Precomputed, band-limited, mip-mapped single-cycle tables for the six oscillator waveforms.
+// Built once per process (on first use) and shared read-only by every processor instance.
+// Mip level k holds at most (maxHarmonics >> k) harmonics, so reading the level chosen from
+// the phase increment never produces partials above Nyquist.
+class Neon37WavetableBank
+{
+public:
+    static constexpr int numWaveforms = 6;     // Same order as the osc*_wave parameters
+    static constexpr int tableSize = 2048;     // Samples per cycle (power of two)
+    static constexpr int numLevels = 11;       // One level per octave: 1024 harmonics down to 1
+    static constexpr int maxHarmonics = tableSize / 2;
+
+    // Shared instance; call once from a non-audio thread (e.g. a constructor) so it is built there
+    static const Neon37WavetableBank& getShared()
+    {
+        static const Neon37WavetableBank bank;
+        return bank;
+    }
+
+    // One sample of waveform at normalized phase t [0, 1), advancing by dt cycles per sample
+    float read (int waveform, float t, float dt) const noexcept
+    {
+        const int level = getLevel (dt);
+        return readTable (getTable (juce::jlimit (0, numWaveforms - 1, waveform), level), t);
+    }
+
+    // Continuous morph between neighbouring waveforms: position 0-5 (0 = Sine ... 5 = 10% Pulse)
+    float readMorph (float position, float t, float dt) const noexcept
+    {
+        position = juce::jlimit (0.0f, (float)(numWaveforms - 1), position);
+        const int wave = juce::jmin ((int)position, numWaveforms - 2);
+        const float blend = position - (float)wave;
+        const int level = getLevel (dt);
+
+        const float a = readTable (getTable (wave, level), t);
+        if (blend <= 0.0f)
+            return a;
+
+        const float b = readTable (getTable (wave + 1, level), t);
+        return a + blend * (b - a);
+    }
+
+private:
+    Neon37WavetableBank()
+        : tables ((size_t)(numWaveforms * numLevels * (tableSize + 1)), 0.0f)
+    {
+        // One sine cycle; harmonic h at index n is sineTable[(h * n) % tableSize]
+        std::vector<float> sineTable ((size_t)tableSize);
+        for (int n = 0; n < tableSize; ++n)
+            sineTable[(size_t)n] = (float)std::sin (juce::MathConstants<double>::twoPi * n / tableSize);
+
+        for (int wave = 0; wave < numWaveforms; ++wave)
+            for (int level = 0; level < numLevels; ++level)
+                buildTable (wave, maxHarmonics >> level, sineTable);
+    }
+
+    // Fourier series of the naive shapes used by Neon37PolyBLEP (same phase and polarity)
+    void buildTable (int wave, int numHarmonics, const std::vector<float>& sineTable)
+    {
+        constexpr double pi = juce::MathConstants<double>::pi;
+        const int mask = tableSize - 1;
+        const int quarter = tableSize / 4;
+
+        std::vector<double> sum ((size_t)tableSize, 0.0);
+
+        auto addHarmonic = [&] (int h, double sinAmp, double cosAmp)
+        {
+            for (int n = 0; n < tableSize; ++n)
+            {
+                const int index = (h * n) & mask;
+                sum[(size_t)n] += sinAmp * sineTable[(size_t)index]
+                                + cosAmp * sineTable[(size_t)((index + quarter) & mask)];
+            }
+        };
+
+        auto addPulse = [&] (double width)
+        {
+            // +1 for t < width, -1 after
+            for (int n = 0; n < tableSize; ++n)
+                sum[(size_t)n] += 2.0 * width - 1.0;
+
+            for (int h = 1; h <= numHarmonics; ++h)
+                addHarmonic (h, 2.0 * (1.0 - std::cos (2.0 * pi * h * width)) / (pi * h),
+                                2.0 * std::sin (2.0 * pi * h * width) / (pi * h));
+        };
+
+        switch (wave)
+        {
+            case 0: // Sine
+                addHarmonic (1, 1.0, 0.0);
+                break;
+
+            case 1: // Triangle: +1 at t = 0, -1 at t = 0.5 (odd cosine harmonics)
+                for (int h = 1; h <= numHarmonics; h += 2)
+                    addHarmonic (h, 0.0, 8.0 / (pi * pi * h * h));
+                break;
+
+            case 2: // Sawtooth: rising 2t - 1
+                for (int h = 1; h <= numHarmonics; ++h)
+                    addHarmonic (h, -2.0 / (pi * h), 0.0);
+                break;
+
+            case 3: addPulse (0.5);  break;  // Square
+            case 4: addPulse (0.25); break;  // 25% Pulse
+            case 5: addPulse (0.10); break;  // 10% Pulse
+            default: break;
+        }
+
+        float* table = tables.data() + tableOffset (wave, (int)std::log2 ((double)maxHarmonics / numHarmonics));
+        for (int n = 0; n < tableSize; ++n)
+            table[n] = (float)sum[(size_t)n];
+        table[tableSize] = table[0];  // Guard point for interpolation
+    }
+
+    // Smallest level whose highest harmonic stays below Nyquist: harmonics <= 0.5 / dt
+    static int getLevel (float dt) noexcept
+    {
+        int exponent = 0;
+        std::frexp ((double)dt * (2.0 * maxHarmonics), &exponent);
+        return juce::jlimit (0, numLevels - 1, exponent);
+    }
+
+    static constexpr size_t tableOffset (int wave, int level)
+    {
+        return (size_t)((wave * numLevels + level) * (tableSize + 1));
+    }
+
+    const float* getTable (int wave, int level) const noexcept
+    {
+        return tables.data() + tableOffset (wave, level);
+    }
+
+    // Linear interpolation (tables carry a guard point, so index + 1 is always valid)
+    static float readTable (const float* table, float t) noexcept
+    {
+        const float position = t * (float)tableSize;
+        const int index = juce::jlimit (0, tableSize - 1, (int)position);
+        const float frac = position - (float)index;
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+
+    std::vector<float> tables;
+
+    JUCE_DECLARE_NON_COPYABLE (Neon37WavetableBank)
+};
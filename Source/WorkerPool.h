@@ -0,0 +1,188 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "RealtimeCheck.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+ #include <immintrin.h>
+#elif defined (_M_ARM64)
+ #include <intrin.h>
+#endif
+
+// Pre-spawned worker threads that run a batch of jobs together with the calling (audio) thread.
+// run() publishes a job function and count; every thread claims job indices from one shared
+// counter (a compare-and-swap each, no locks) until none are left, and run() returns once every
+// job has finished. Between batches workers spin for a while, then park on a futex
+// (std::atomic::wait); the caller never sleeps, it only spins while the last jobs finish.
+// start() and stop() belong to the message thread (prepareToPlay), never concurrent with run().
+class Neon37WorkerPool
+{
+public:
+    using JobFunction = void (*) (void* context, int jobIndex);
+
+    ~Neon37WorkerPool() { stop(); }
+
+    void start (int numWorkers, const juce::Thread::RealtimeOptions& options)
+    {
+        stop();
+        quit.store (false);
+
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            workers.push_back (std::make_unique<Worker> (*this, i));
+            if (! workers.back()->startRealtimeThread (options))
+                workers.back()->startThread (juce::Thread::Priority::highest);
+        }
+    }
+
+    void stop()
+    {
+        if (workers.empty())
+            return;
+
+        quit.store (true);
+        generation.fetch_add (1);
+        generation.notify_all();
+
+        for (auto& worker : workers)
+            worker->stopThread (-1);
+
+        workers.clear();
+    }
+
+    int getNumWorkers() const noexcept { return (int)workers.size(); }
+
+    // CPU hint for one iteration of a spin-wait loop
+    static inline void pause() noexcept
+    {
+       #if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+        _mm_pause();
+       #elif defined (_M_ARM64)
+        __yield();
+       #elif defined (__aarch64__) || defined (__arm__)
+        __asm__ __volatile__ ("yield");
+       #endif
+    }
+
+    // Run function (context, 0 .. numJobs - 1) across the workers and the calling thread
+    void run (JobFunction function, void* context, int numJobs) noexcept
+    {
+        const uint32_t gen = generation.load (std::memory_order_relaxed) + 1;
+
+        auto& batch = batches[gen & 1];
+        batch.function = function;
+        batch.context = context;
+        batch.numJobs.store (numJobs, std::memory_order_relaxed);
+        jobsDone.store (0, std::memory_order_relaxed);
+
+        nextJob.store ((uint64_t)gen << 32, std::memory_order_release);
+        generation.store (gen);
+
+        if (numParked.load() > 0)
+            generation.notify_all();
+
+        runJobs (gen);
+
+        while (jobsDone.load (std::memory_order_acquire) < numJobs)
+            pause();
+    }
+
+private:
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker (Neon37WorkerPool& owner, int index)
+            : juce::Thread ("Neon37 voice worker " + juce::String (index)), pool (owner) {}
+
+        void run() override
+        {
+            juce::ScopedNoDenormals noDenormals;
+            pool.workerLoop();
+        }
+
+    private:
+        Neon37WorkerPool& pool;
+    };
+
+    // Batches alternate between two slots by generation parity. A slot is only rewritten two
+    // batches later, after every job of its batch has finished, so a thread that claimed a job
+    // (its claim carries the generation) always reads the batch that job belongs to.
+    struct Batch
+    {
+        JobFunction function = nullptr;
+        void* context = nullptr;
+        std::atomic<int> numJobs { 0 };
+    };
+
+    // Spin iterations before a worker parks (a few hundred microseconds, about one short audio block)
+    static constexpr int spinsBeforeParking = 20000;
+
+    void workerLoop()
+    {
+        uint32_t seen = generation.load();
+
+        for (;;)
+        {
+            uint32_t gen = generation.load (std::memory_order_acquire);
+            for (int spin = 0; gen == seen && spin < spinsBeforeParking; ++spin)
+            {
+                pause();
+                gen = generation.load (std::memory_order_acquire);
+            }
+
+            if (gen == seen)
+            {
+                numParked.fetch_add (1);
+                generation.wait (seen);
+                numParked.fetch_sub (1);
+                gen = generation.load (std::memory_order_acquire);
+            }
+
+            if (quit.load())
+                return;
+
+            runJobs (gen);
+            seen = gen;
+        }
+    }
+
+    // Claim and run jobs of batch gen until none are left (or a newer batch has replaced it)
+    void runJobs (uint32_t gen) noexcept
+    {
+        NEON37_REALTIME_SCOPE
+        auto& batch = batches[gen & 1];
+
+        for (;;)
+        {
+            uint64_t claim = nextJob.load (std::memory_order_acquire);
+            int index = 0;
+            do
+            {
+                if ((uint32_t)(claim >> 32) != gen)
+                    return;
+
+                index = (int)(uint32_t)claim;
+                if (index >= batch.numJobs.load (std::memory_order_relaxed))
+                    return;
+            }
+            while (! nextJob.compare_exchange_weak (claim, claim + 1, std::memory_order_acq_rel, std::memory_order_acquire));
+
+            batch.function (batch.context, index);
+            jobsDone.fetch_add (1, std::memory_order_release);
+        }
+    }
+
+    std::array<Batch, 2> batches;
+    std::atomic<uint64_t> nextJob { 0 };      // (generation << 32) | next unclaimed job index
+    std::atomic<uint32_t> generation { 0 };   // Bumped per batch; 32-bit so parked workers wait on a futex
+    std::atomic<int> jobsDone { 0 };
+    std::atomic<int> numParked { 0 };
+    std::atomic<bool> quit { false };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+};
@@ -0,0 +1,164 @@
+// Accuracy test for the Neon37_FastMathTest build.
+//
+// Sweeps each approximation in Source/FastMath.h over the input range stated in that file's
+// header comment and compares it against double-precision libm. A function fails when its max
+// error exceeds the bound documented there. Exit code is the number of failures (0 = all within
+// their bounds).
+//
+// Usage: Neon37_FastMathTest
+
+#include "../../Source/FastMath.h"
+
+#if ! NEON37_FAST_MATH
+ #error "The fast-math test must be built with NEON37_FAST_MATH=1"
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    constexpr int sweepPoints = 1 << 24;
+
+    enum class Metric { absolute, relative };
+
+    struct MaxError
+    {
+        double error = 0.0;
+        float worstInput = 0.0f;
+
+        void add (float x, float approx, double reference, Metric metric) noexcept
+        {
+            double e = std::abs ((double)approx - reference);
+            if (metric == Metric::relative)
+                e /= std::abs (reference);
+
+            if (! (e <= error))    // Also catches NaN
+            {
+                error = e;
+                worstInput = x;
+            }
+        }
+    };
+
+    float floatFromBits (uint32_t bits) noexcept
+    {
+        float x;
+        std::memcpy (&x, &bits, sizeof (x));
+        return x;
+    }
+
+    uint32_t bitsFromFloat (float x) noexcept
+    {
+        uint32_t bits;
+        std::memcpy (&bits, &x, sizeof (bits));
+        return bits;
+    }
+
+    // Evenly spaced points covering [lo, hi] (both ends included)
+    template <typename Fn>
+    void sweepLinear (float lo, float hi, Fn&& fn)
+    {
+        for (int i = 0; i <= sweepPoints; ++i)
+            fn ((float)((double)lo + ((double)hi - (double)lo) * (double)i / (double)sweepPoints));
+    }
+
+    // Every stride-th float in [lo, hi] by bit pattern (positive lo and hi)
+    template <typename Fn>
+    void sweepBits (float lo, float hi, uint32_t stride, Fn&& fn)
+    {
+        const uint32_t last = bitsFromFloat (hi);
+        for (uint32_t bits = bitsFromFloat (lo); bits <= last; bits += stride)
+            fn (floatFromBits (bits));
+    }
+
+    int failures = 0;
+
+    void report (const char* name, const MaxError& result, double bound, Metric metric)
+    {
+        const bool ok = result.error <= bound;
+        if (! ok)
+            ++failures;
+
+        std::printf ("%-26s %s %.3g (bound %.3g, %s, worst at x = %.9g)\n",
+                     name, ok ? "ok  " : "FAIL", result.error, bound,
+                     metric == Metric::relative ? "relative" : "absolute", (double)result.worstInput);
+    }
+
+    void testExp2()
+    {
+        MaxError result;
+        sweepLinear (-126.0f, 126.0f, [&] (float x)
+        {
+            result.add (x, Neon37FastMath::exp2 (x), std::exp2 ((double)x), Metric::relative);
+        });
+        report ("exp2 [-126, 126]", result, 2.6e-7, Metric::relative);
+    }
+
+    void testLog2()
+    {
+        // Every float in [0.5, 2]
+        MaxError inner;
+        sweepBits (0.5f, 2.0f, 1, [&] (float x)
+        {
+            inner.add (x, Neon37FastMath::log2 (x), std::log2 ((double)x), Metric::absolute);
+        });
+        report ("log2 [0.5, 2]", inner, 1.8e-7, Metric::absolute);
+
+        // The rest of the normal range, sampled by bit pattern so every binade is covered
+        MaxError outer;
+        auto addOuter = [&] (float x)
+        {
+            outer.add (x, Neon37FastMath::log2 (x), std::log2 ((double)x), Metric::relative);
+        };
+        sweepBits (std::numeric_limits<float>::min(), std::nextafter (0.5f, 0.0f), 61, addOuter);
+        sweepBits (std::nextafter (2.0f, 4.0f), std::numeric_limits<float>::max(), 61, addOuter);
+        report ("log2 other normal x > 0", outer, 1.4e-7, Metric::relative);
+    }
+
+    void testSin2Pi()
+    {
+        MaxError result;
+        sweepLinear (0.0f, std::nextafter (1.0f, 0.0f), [&] (float cycles)
+        {
+            result.add (cycles, Neon37FastMath::sin2Pi (cycles),
+                        std::sin (6.283185307179586 * (double)cycles), Metric::absolute);
+        });
+        report ("sin2Pi [0, 1)", result, 2.2e-7, Metric::absolute);
+    }
+
+    void testTanh()
+    {
+        MaxError result;
+        sweepLinear (-20.0f, 20.0f, [&] (float x)
+        {
+            result.add (x, Neon37FastMath::tanh (x), std::tanh ((double)x), Metric::absolute);
+        });
+        report ("tanh [-20, 20]", result, 1.6e-7, Metric::absolute);
+    }
+
+    void testTanhRational()
+    {
+        MaxError result;
+        sweepLinear (-20.0f, 20.0f, [&] (float x)
+        {
+            result.add (x, Neon37FastMath::tanhRational (x), std::tanh ((double)x), Metric::absolute);
+        });
+        report ("tanhRational [-20, 20]", result, 9.7e-5, Metric::absolute);
+    }
+}
+
+int main()
+{
+    testExp2();
+    testLog2();
+    testSin2Pi();
+    testTanh();
+    testTanhRational();
+
+    std::printf ("%d failure(s)\n", failures);
+    return failures;
+}
@@ -0,0 +1,306 @@
+// Linux interposer for the Neon37_RTCheck build.
+//
+// Replaces malloc/free/calloc/realloc, global operator new/delete, pthread mutex/condvar/rwlock
+// entry points and common blocking syscalls. While a thread is inside processBlock (marked via
+// Neon37RealtimeCheck::ScopedAudioThread) every call is reported with a stack trace, then
+// forwarded to the real implementation so the run continues.
+
+#include "../../Source/RealtimeCheck.h"
+#include "RTCheckInterposer.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+
+// glibc's underlying allocator entry points (exported, never interposed)
+extern "C" void* __libc_malloc (size_t);
+extern "C" void  __libc_free (void*);
+extern "C" void* __libc_calloc (size_t, size_t);
+extern "C" void* __libc_realloc (void*, size_t);
+extern "C" void* __libc_memalign (size_t, size_t);
+
+namespace
+{
+    thread_local int audioThreadDepth = 0;
+    thread_local bool reporting = false;
+
+    std::atomic<int> violationCount { 0 };
+    std::atomic<bool> abortOnViolation { false };
+
+    // Write without going through stdio (stdio locks and may allocate)
+    void writeRaw (const char* text)
+    {
+        [[maybe_unused]] auto written = ::write (STDERR_FILENO, text, std::strlen (text));
+    }
+
+    void report (const char* what)
+    {
+        if (audioThreadDepth == 0 || reporting)
+            return;
+
+        reporting = true;
+        const int count = ++violationCount;
+
+        char header[160];
+        std::snprintf (header, sizeof (header), "\n[RTCheck] #%d: %s called on the audio thread\n", count, what);
+        writeRaw (header);
+
+        void* frames[64];
+        const int numFrames = backtrace (frames, 64);
+        backtrace_symbols_fd (frames, numFrames, STDERR_FILENO);
+
+        if (abortOnViolation.load())
+            std::abort();
+
+        reporting = false;
+    }
+
+    // Real implementations, resolved lazily (other static constructors may lock before ours runs)
+    struct NextFunctions
+    {
+        int (*mutexLock) (pthread_mutex_t*) = nullptr;
+        int (*condWait) (pthread_cond_t*, pthread_mutex_t*) = nullptr;
+        int (*condTimedWait) (pthread_cond_t*, pthread_mutex_t*, const struct timespec*) = nullptr;
+        int (*rwlockRdlock) (pthread_rwlock_t*) = nullptr;
+        int (*rwlockWrlock) (pthread_rwlock_t*) = nullptr;
+        int (*semWait) (sem_t*) = nullptr;
+        int (*nanosleep) (const struct timespec*, struct timespec*) = nullptr;
+        int (*usleep) (useconds_t) = nullptr;
+        unsigned int (*sleep) (unsigned int) = nullptr;
+        ssize_t (*read) (int, void*, size_t) = nullptr;
+        ssize_t (*write) (int, const void*, size_t) = nullptr;
+    };
+
+    NextFunctions next;
+
+    template <typename Fn>
+    Fn resolveNext (Fn& cached, const char* name)
+    {
+        if (cached == nullptr)
+            cached = reinterpret_cast<Fn> (dlsym (RTLD_NEXT, name));
+        return cached;
+    }
+
+    struct Bootstrap
+    {
+        Bootstrap()
+        {
+            // Resolve everything up front so dlsym never runs (and allocates) on the audio thread
+            resolveNext (next.mutexLock, "pthread_mutex_lock");
+            resolveNext (next.condWait, "pthread_cond_wait");
+            resolveNext (next.condTimedWait, "pthread_cond_timedwait");
+            resolveNext (next.rwlockRdlock, "pthread_rwlock_rdlock");
+            resolveNext (next.rwlockWrlock, "pthread_rwlock_wrlock");
+            resolveNext (next.semWait, "sem_wait");
+            resolveNext (next.nanosleep, "nanosleep");
+            resolveNext (next.usleep, "usleep");
+            resolveNext (next.sleep, "sleep");
+            resolveNext (next.read, "read");
+            resolveNext (next.write, "write");
+
+            // backtrace() lazily loads libgcc on first use (which allocates); prime it here
+            void* frames[4];
+            backtrace (frames, 4);
+        }
+    };
+
+    Bootstrap bootstrap;
+}
+
+//==============================================================================
+void Neon37RealtimeCheck::enterAudioThread() noexcept   { ++audioThreadDepth; }
+void Neon37RealtimeCheck::exitAudioThread() noexcept    { --audioThreadDepth; }
+
+int  Neon37RTCheck::getViolationCount() noexcept         { return violationCount.load(); }
+void Neon37RTCheck::resetViolationCount() noexcept       { violationCount = 0; }
+void Neon37RTCheck::setAbortOnViolation (bool shouldAbort) noexcept { abortOnViolation = shouldAbort; }
+
+//==============================================================================
+// Allocation
+extern "C"
+{
+    void* malloc (size_t size)
+    {
+        report ("malloc");
+        return __libc_malloc (size);
+    }
+
+    void free (void* ptr)
+    {
+        if (ptr != nullptr)
+            report ("free");
+        __libc_free (ptr);
+    }
+
+    void* calloc (size_t num, size_t size)
+    {
+        report ("calloc");
+        return __libc_calloc (num, size);
+    }
+
+    void* realloc (void* ptr, size_t size)
+    {
+        report ("realloc");
+        return __libc_realloc (ptr, size);
+    }
+
+    int posix_memalign (void** result, size_t alignment, size_t size)
+    {
+        report ("posix_memalign");
+        *result = __libc_memalign (alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void* aligned_alloc (size_t alignment, size_t size)
+    {
+        report ("aligned_alloc");
+        return __libc_memalign (alignment, size);
+    }
+}
+
+void* operator new (size_t size)
+{
+    report ("operator new");
+    if (auto* ptr = __libc_malloc (size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (size_t size)
+{
+    report ("operator new[]");
+    if (auto* ptr = __libc_malloc (size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new (size_t size, const std::nothrow_t&) noexcept
+{
+    report ("operator new");
+    return __libc_malloc (size);
+}
+
+void* operator new[] (size_t size, const std::nothrow_t&) noexcept
+{
+    report ("operator new[]");
+    return __libc_malloc (size);
+}
+
+void* operator new (size_t size, std::align_val_t alignment)
+{
+    report ("operator new (aligned)");
+    if (auto* ptr = __libc_memalign ((size_t) alignment, size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (size_t size, std::align_val_t alignment)
+{
+    report ("operator new[] (aligned)");
+    if (auto* ptr = __libc_memalign ((size_t) alignment, size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete (void* ptr) noexcept
+{
+    if (ptr != nullptr)
+        report ("operator delete");
+    __libc_free (ptr);
+}
+
+void operator delete[] (void* ptr) noexcept
+{
+    if (ptr != nullptr)
+        report ("operator delete[]");
+    __libc_free (ptr);
+}
+
+void operator delete (void* ptr, size_t) noexcept                        { operator delete (ptr); }
+void operator delete[] (void* ptr, size_t) noexcept                      { operator delete[] (ptr); }
+void operator delete (void* ptr, std::align_val_t) noexcept              { operator delete (ptr); }
+void operator delete[] (void* ptr, std::align_val_t) noexcept            { operator delete[] (ptr); }
+void operator delete (void* ptr, size_t, std::align_val_t) noexcept      { operator delete (ptr); }
+void operator delete[] (void* ptr, size_t, std::align_val_t) noexcept    { operator delete[] (ptr); }
+
+//==============================================================================
+// Locks and blocking calls
+extern "C"
+{
+    int pthread_mutex_lock (pthread_mutex_t* mutex)
+    {
+        report ("pthread_mutex_lock");
+        return resolveNext (next.mutexLock, "pthread_mutex_lock") (mutex);
+    }
+
+    int pthread_cond_wait (pthread_cond_t* cond, pthread_mutex_t* mutex)
+    {
+        report ("pthread_cond_wait");
+        return resolveNext (next.condWait, "pthread_cond_wait") (cond, mutex);
+    }
+
+    int pthread_cond_timedwait (pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* abstime)
+    {
+        report ("pthread_cond_timedwait");
+        return resolveNext (next.condTimedWait, "pthread_cond_timedwait") (cond, mutex, abstime);
+    }
+
+    int pthread_rwlock_rdlock (pthread_rwlock_t* lock)
+    {
+        report ("pthread_rwlock_rdlock");
+        return resolveNext (next.rwlockRdlock, "pthread_rwlock_rdlock") (lock);
+    }
+
+    int pthread_rwlock_wrlock (pthread_rwlock_t* lock)
+    {
+        report ("pthread_rwlock_wrlock");
+        return resolveNext (next.rwlockWrlock, "pthread_rwlock_wrlock") (lock);
+    }
+
+    int sem_wait (sem_t* sem)
+    {
+        report ("sem_wait");
+        return resolveNext (next.semWait, "sem_wait") (sem);
+    }
+
+    int nanosleep (const struct timespec* req, struct timespec* rem)
+    {
+        report ("nanosleep");
+        return resolveNext (next.nanosleep, "nanosleep") (req, rem);
+    }
+
+    int usleep (useconds_t usec)
+    {
+        report ("usleep");
+        return resolveNext (next.usleep, "usleep") (usec);
+    }
+
+    unsigned int sleep (unsigned int seconds)
+    {
+        report ("sleep");
+        return resolveNext (next.sleep, "sleep") (seconds);
+    }
+
+    ssize_t read (int fd, void* buf, size_t count)
+    {
+        report ("read");
+        return resolveNext (next.read, "read") (fd, buf, count);
+    }
+
+    ssize_t write (int fd, const void* buf, size_t count)
+    {
+        report ("write");
+        return resolveNext (next.write, "write") (fd, buf, count);
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+// Control surface of the RTCheck interposer, used by the headless driver
+struct Neon37RTCheck
+{
+    // Number of violations reported since start (or since the last reset)
+    static int getViolationCount() noexcept;
+    static void resetViolationCount() noexcept;
+
+    // Abort on the first violation (useful under a debugger)
+    static void setAbortOnViolation (bool shouldAbort) noexcept;
+};
@@ -0,0 +1,235 @@
+// Headless driver for the Neon37_RTCheck build.
+//
+// Runs processBlock through every voice mode (Mono-L, Mono, Para-L, Para, Poly) and then through
+// every factory preset, with a MIDI pattern that exercises note-on/off, voice stealing, pitch bend,
+// mod wheel and aftertouch. The interposer reports any allocation, lock or blocking call made
+// from inside processBlock. Exit code is the number of violations (0 = real-time safe).
+//
+// Usage: Neon37_RTCheck [--abort] [--presets <dir>]
+
+#include "../../Source/PluginProcessor.h"
+#include "RTCheckInterposer.h"
+
+#include <juce_events/juce_events.h>
+#include <iostream>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 64;
+    constexpr int blocksPerRun = 1500;   // ~2 s per voice mode / preset
+
+    void setParameter (Neon37AudioProcessor& processor, const juce::String& id, float plainValue)
+    {
+        if (auto* param = processor.apvts.getParameter (id))
+            param->setValueNotifyingHost (param->convertTo0to1 (plainValue));
+    }
+
+    // MIDI for block index `block` of a run: a 10-note chord (forces stealing in Para/Poly),
+    // modulation sweeps while held, then release and let the tails ring out
+    void fillMidi (juce::MidiBuffer& midi, int block)
+    {
+        midi.clear();
+
+        static constexpr int chord[] = { 48, 52, 55, 60, 64, 67, 72, 76, 79, 84 };
+
+        if (block == 10)
+            for (int i = 0; i < (int)std::size (chord); ++i)
+                midi.addEvent (juce::MidiMessage::noteOn (1, chord[i], (juce::uint8)(40 + i * 8)), (i * 7) % blockSize);
+
+        if (block > 10 && block < 600 && block % 25 == 0)
+        {
+            midi.addEvent (juce::MidiMessage::pitchWheel (1, 8192 + ((block * 97) % 4096) - 2048), 3);
+            midi.addEvent (juce::MidiMessage::controllerEvent (1, 1, (block / 25) % 128), 17);
+            midi.addEvent (juce::MidiMessage::channelPressureChange (1, (block / 5) % 128), 33);
+            midi.addEvent (juce::MidiMessage::aftertouchChange (1, chord[(block / 25) % 10], 100), 49);
+        }
+
+        // Retrigger a held note (duplicate-note handling) and play a quick legato run
+        if (block == 300)
+            midi.addEvent (juce::MidiMessage::noteOn (1, 60, (juce::uint8)100), 0);
+        if (block >= 320 && block < 340)
+        {
+            midi.addEvent (juce::MidiMessage::noteOn (1, 36 + (block - 320), (juce::uint8)90), 5);
+            midi.addEvent (juce::MidiMessage::noteOff (1, 36 + (block - 320)), 60);
+        }
+
+        if (block == 600)
+            for (int i = 0; i < (int)std::size (chord); ++i)
+                midi.addEvent (juce::MidiMessage::noteOff (1, chord[i]), (i * 5) % blockSize);
+    }
+
+    // One host block of MIDI far denser than the processor reserves for a chunk of an oversized
+    // block: a chord, a controller/pitch-bend sweep on every sample, and the chord's note-offs
+    juce::MidiBuffer makeMidiBurst (int hostBlockSize)
+    {
+        static constexpr int chord[] = { 48, 52, 55, 60, 64, 67, 72, 76, 79, 84 };
+        constexpr int eventsPerSample = 32;
+
+        juce::MidiBuffer midi;
+        for (int i = 0; i < (int)std::size (chord); ++i)
+            midi.addEvent (juce::MidiMessage::noteOn (1, chord[i], (juce::uint8)100), 0);
+
+        for (int sample = 0; sample < hostBlockSize; ++sample)
+            for (int i = 0; i < eventsPerSample; ++i)
+                midi.addEvent (i % 2 == 0 ? juce::MidiMessage::controllerEvent (1, 1, (sample + i) % 128)
+                                          : juce::MidiMessage::pitchWheel (1, (sample * 64 + i) % 16384), sample);
+
+        for (int i = 0; i < (int)std::size (chord); ++i)
+            midi.addEvent (juce::MidiMessage::noteOff (1, chord[i]), hostBlockSize - 1);
+
+        return midi;
+    }
+
+    // Renders blocksPerRun host blocks of hostBlockSize samples, with fillMidi's pattern or, when
+    // given, the same fixedMidi every block
+    int render (Neon37AudioProcessor& processor, const juce::String& label, int hostBlockSize = blockSize,
+                const juce::MidiBuffer* fixedMidi = nullptr)
+    {
+        juce::AudioBuffer<float> buffer (2, hostBlockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize (4096);
+
+        const int before = Neon37RTCheck::getViolationCount();
+
+        for (int block = 0; block < blocksPerRun; ++block)
+        {
+            if (fixedMidi != nullptr)
+                midi = *fixedMidi;
+            else
+                fillMidi (midi, block);
+
+            buffer.clear();
+            processor.processBlock (buffer, midi);
+        }
+
+        const int violations = Neon37RTCheck::getViolationCount() - before;
+        std::cout << (violations == 0 ? "  ok    " : "  FAIL  ") << label << " (" << violations << " violations)" << std::endl;
+        return violations;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::File presetsDir (NEON37_RTCHECK_PRESETS_DIR);
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+
+        if (arg == "--abort")
+            Neon37RTCheck::setAbortOnViolation (true);
+        else if (arg == "--presets" && i + 1 < argc)
+            presetsDir = juce::File::getCurrentWorkingDirectory().getChildFile (argv[++i]);
+    }
+
+    auto processor = std::make_unique<Neon37AudioProcessor>();
+    processor->setPlayConfigDetails (0, 2, sampleRate, blockSize);
+    processor->prepareToPlay (sampleRate, blockSize);
+
+    Neon37RTCheck::resetViolationCount();
+    int totalViolations = 0;
+
+    // Every voice mode with a patch that turns on all sources and modulation
+    setParameter (*processor, "mixer_osc2", 0.0f);
+    setParameter (*processor, "mixer_sub1", -6.0f);
+    setParameter (*processor, "mixer_noise", -20.0f);
+    setParameter (*processor, "glide_time", 80.0f);
+    setParameter (*processor, "hard_sync", 1.0f);
+    setParameter (*processor, "env_pitch_depth", 7.0f);
+    setParameter (*processor, "eg_depth", 60.0f);
+    setParameter (*processor, "lfo1_filter", 0.5f);
+    setParameter (*processor, "lfo2_pitch", 0.1f);
+    setParameter (*processor, "vel_filter", 1.0f);
+    setParameter (*processor, "at_amp", 0.5f);
+    setParameter (*processor, "mw_filter", 1.0f);
+
+    static const char* voiceModeNames[] = { "Mono-L", "Mono", "Para-L", "Para", "Poly" };
+
+    std::cout << "Voice modes:" << std::endl;
+    for (int voiceMode = 0; voiceMode < 5; ++voiceMode)
+    {
+        setParameter (*processor, "voice_mode", (float)voiceMode);
+        totalViolations += render (*processor, juce::String ("voice_mode ") + juce::String (voiceMode) + " (" + voiceModeNames[voiceMode] + ")");
+    }
+
+    // Wavetable oscillator engine with morphing (Poly, the heaviest path)
+    setParameter (*processor, "osc_engine", 1.0f);
+    setParameter (*processor, "osc1_morph", 0.5f);
+    totalViolations += render (*processor, "osc_engine Wavetable (Poly)");
+    setParameter (*processor, "osc_engine", 0.0f);
+    setParameter (*processor, "osc1_morph", 0.0f);
+
+    // Polyphony changes are picked up inside processBlock and must not allocate (Poly, then Para)
+    setParameter (*processor, "voice_count", 64.0f);
+    totalViolations += render (*processor, "voice_count 64 (Poly)");
+    setParameter (*processor, "voice_mode", 3.0f);
+    setParameter (*processor, "voice_count", 4.0f);
+    totalViolations += render (*processor, "voice_count 4 (Para)");
+    setParameter (*processor, "voice_mode", 4.0f);
+
+    // Stealing policies with the pool exhausted (Poly, 4 voices)
+    setParameter (*processor, "voice_steal", 1.0f);
+    totalViolations += render (*processor, "voice_steal Quietest (Poly)");
+    setParameter (*processor, "voice_steal", 2.0f);
+    totalViolations += render (*processor, "voice_steal Releasing First (Poly)");
+    setParameter (*processor, "voice_steal", 0.0f);
+    setParameter (*processor, "voice_count", 8.0f);
+
+    // Unison stacks (8 copies): every voice renders its own detuned copies (Poly, then Mono)
+    setParameter (*processor, "unison_voices", 8.0f);
+    totalViolations += render (*processor, "unison_voices 8 (Poly)");
+    setParameter (*processor, "voice_mode", 1.0f);
+    totalViolations += render (*processor, "unison_voices 8 (Mono)");
+    setParameter (*processor, "voice_mode", 4.0f);
+    setParameter (*processor, "unison_voices", 1.0f);
+
+    // Host blocks larger than announced in prepareToPlay are split into prepared-size chunks
+    totalViolations += render (*processor, "oversized host blocks 4x (Poly)", blockSize * 4 + 7);
+    const auto midiBurst = makeMidiBurst (blockSize * 4 + 7);
+    totalViolations += render (*processor, "oversized host blocks 4x, dense MIDI (Poly)", blockSize * 4 + 7, &midiBurst);
+
+    // Threaded Poly rendering (4 threads): workers start when re-preparing, as the processor's timer would
+    setParameter (*processor, "poly_threads", 2.0f);
+    processor->prepareToPlay (sampleRate, blockSize);
+    totalViolations += render (*processor, "poly_threads 4 (Poly)");
+    setParameter (*processor, "poly_threads", 0.0f);
+    processor->prepareToPlay (sampleRate, blockSize);
+
+    // Render-ahead (256-sample chunks, Poly): blocks arrive faster than real time here, so this also
+    // covers the inline fallback when the worker falls behind
+    setParameter (*processor, "render_ahead", 1.0f);
+    processor->prepareToPlay (sampleRate, blockSize);
+    totalViolations += render (*processor, "render_ahead 256 (Poly)");
+    setParameter (*processor, "render_ahead", 0.0f);
+    processor->prepareToPlay (sampleRate, blockSize);
+
+    // HQ mode (8x, Poly): the change is applied by re-preparing, as the processor's timer would
+    setParameter (*processor, "hq_mode", 3.0f);
+    processor->prepareToPlay (sampleRate, blockSize);
+    totalViolations += render (*processor, "hq_mode 8x (Poly)");
+    setParameter (*processor, "hq_mode", 0.0f);
+    processor->prepareToPlay (sampleRate, blockSize);
+
+    // Preset-load path: load each factory preset on this (message) thread, then render
+    std::cout << "Presets from " << presetsDir.getFullPathName() << ":" << std::endl;
+    for (const auto& entry : juce::RangedDirectoryIterator (presetsDir, true, "*.xml"))
+    {
+        const auto file = entry.getFile();
+
+        if (! processor->loadPresetFromFile (file))
+        {
+            std::cout << "  skip  " << file.getFileName() << " (not a Neon37 preset)" << std::endl;
+            continue;
+        }
+
+        totalViolations += render (*processor, file.getFileName());
+    }
+
+    processor->releaseResources();
+
+    std::cout << (totalViolations == 0 ? "PASS" : "FAIL") << ": " << totalViolations << " real-time violations" << std::endl;
+    return juce::jmin (totalViolations, 255);
+}